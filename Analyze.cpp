@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Analyze.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Analysis tool. It searches position (refer to Search.h) and
+//              prints every finished depth and best move.
+//
+//              Usage: analyze [-depth N] [-nodes N] [-time MS] [-soft MS]
+//                             [-fen FEN] [-threads N] [-hash MB] [-tb DIR]
+//                             [-book FILE] [move ...]
+//                     analyze -bench [-depth N] [-threads N] [-hash MB]
+//              Search starts from starting position or from position given
+//              as FEN (in quotes), after moves in format E2E4 are played.
+//              Without limits, search runs to depth 6. -time is hard time
+//              limit and -soft is time search should use (refer to
+//              SearchLimits in Search.h); with -time, tool also prints by
+//              how much search overshot the limit. With -tb, endgame tables
+//              from directory DIR are used (refer to Tablebase.h) and result
+//              of position from tables is printed, if it is there. With
+//              -book, moves of position in Polyglot opening book FILE are
+//              printed with their share of weight (refer to Book.h).
+//
+//              With -bench, fixed set of positions is searched to given
+//              depth with 1, 2, 4, ... up to N threads (default: all cores).
+//              For every number of threads it prints time, nodes, speed and
+//              speedup (time with one thread / time with N threads).
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <chrono>
+
+using namespace std;
+
+#include "ChessBoard.hpp"
+#include "Search.h"
+#include "Book.h"
+
+// Default depth, if no limit is given.
+static const int DEFAULT_DEPTH = 6;
+
+// Positions searched by benchmark: opening, middlegames and endgame.
+static const char* BENCH_POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - - 0 1",
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w - - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w - - 0 1",
+    "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w - - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"
+};
+static const int BENCH_COUNT = sizeof(BENCH_POSITIONS) / sizeof(char*);
+
+// CLASS: PrintListener
+// ====================
+// Prints every finished depth to "cout".
+class PrintListener: public SearchListener {
+public:
+    void iteration(const SearchInfo& info) {
+        print_search_info(cout, info);
+        cout.flush();
+    }
+};
+
+// Function play move.
+// Plays legal move written as "E2E4". Returns false if move is written wrong
+// or isn't legal.
+static bool play_move(ChessBoard& board, string_view move_str) {
+    if(move_str.length() != 4) return false;
+    return board.submitMove(move_str.substr(0, 2), move_str.substr(2, 2));
+}
+
+// Function bench.
+// Searches all benchmark positions with 1, 2, 4, ... "max_threads" threads.
+// Every run starts with empty transposition table.
+static void bench(int depth, int max_threads, int hash_mb) {
+    double base_seconds = 0;
+
+    for(int threads=1; ; threads *= 2) {
+        if(threads > max_threads) threads = max_threads;
+
+        Search search(threads, hash_mb);
+        SearchLimits limits;
+        Count nodes = 0;
+
+        limits.depth = depth;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for(int i=0; i<BENCH_COUNT; i++) {
+            ChessBoard board(NULL);
+
+            board.from_fen(BENCH_POSITIONS[i]);
+            search.clear();
+            search.think(board, limits);
+            nodes += search.get_info().nodes;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                                  - start).count();
+        if(threads == 1) base_seconds = seconds;
+
+        cout << "threads " << threads << " time " << seconds
+             << " nodes " << nodes << " nps "
+             << static_cast<Count>(seconds > 0 ? nodes / seconds : 0)
+             << " speedup " << (seconds > 0 ? base_seconds / seconds : 0)
+             << "\n";
+        cout.flush();
+
+        if(threads == max_threads) break;
+    }
+}
+
+// Function print book moves.
+// Prints moves of position in book, each with its share of all weights.
+static void print_book_moves(const Book& book, const ChessBoard& board) {
+    BookMove moves[BOOK_MAX_MOVES];
+    int found = book.find_moves(board.get_position(), board.get_turn(),
+                                moves, BOOK_MAX_MOVES);
+    long long total = 0;
+
+    cout << "Book:";
+    for(int i=0; i<found; i++)
+        total += moves[i].weight;
+    for(int i=0; i<found; i++) {
+        cout << " " << moves[i].move.start() << moves[i].move.end() << " ("
+             << (total > 0 ? 100 * moves[i].weight / total : 0) << "%)";
+    }
+    if(found == 0) cout << " position is not in book";
+    cout << "\n";
+}
+
+// Function print usage.
+static void print_usage() {
+    cerr << "Usage: analyze [-depth N] [-nodes N] [-time MS] [-soft MS]"
+         << " [-fen FEN] [-threads N] [-hash MB] [-tb DIR]" << endl;
+    cerr << "               [-book FILE] [move ...]" << endl;
+    cerr << "       analyze -bench [-depth N] [-threads N] [-hash MB]"
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+    ChessBoard board(NULL);
+    SearchLimits limits;
+    PrintListener listener;
+    int threads = 0, hash_mb = DEFAULT_HASH_MB;
+    bool run_bench = false;
+    Tablebase tablebase;
+    Book book;
+
+    for(int i=1; i<argc; i++) {
+        string arg = argv[i];
+
+        if(arg == "-depth" && i+1 < argc) {
+            limits.depth = atoi(argv[++i]);
+        }
+        else if(arg == "-nodes" && i+1 < argc) {
+            limits.nodes = atoll(argv[++i]);
+        }
+        else if(arg == "-time" && i+1 < argc) {
+            limits.milliseconds = atoi(argv[++i]);
+        }
+        else if(arg == "-soft" && i+1 < argc) {
+            limits.soft_milliseconds = atoi(argv[++i]);
+        }
+        else if(arg == "-threads" && i+1 < argc) {
+            threads = atoi(argv[++i]);
+        }
+        else if(arg == "-hash" && i+1 < argc) {
+            hash_mb = atoi(argv[++i]);
+        }
+        else if(arg == "-tb" && i+1 < argc) {
+            if(tablebase.open(argv[++i]) == 0) {
+                cerr << "No tables in " << argv[i] << "!" << endl;
+                return 1;
+            }
+        }
+        else if(arg == "-book" && i+1 < argc) {
+            if(!book.open(argv[++i])) {
+                cerr << "Can't open book " << argv[i] << "!" << endl;
+                return 1;
+            }
+        }
+        else if(arg == "-bench") {
+            run_bench = true;
+        }
+        else if(arg == "-fen" && i+1 < argc) {
+            if(!board.from_fen(argv[++i])) {
+                cerr << "Invalid FEN " << argv[i] << "!" << endl;
+                return 1;
+            }
+        }
+        else if(arg[0] == '-') {
+            print_usage();
+            return 1;
+        }
+        else if(!play_move(board, arg)) {
+            cerr << "Illegal move " << arg << "!" << endl;
+            return 1;
+        }
+    }
+
+    if(limits.depth <= 0 && limits.nodes == 0 && limits.milliseconds <= 0
+       && limits.soft_milliseconds <= 0)
+        limits.depth = DEFAULT_DEPTH;
+
+    if(run_bench) {
+        if(threads < 1) threads = thread::hardware_concurrency();
+        bench(limits.depth, threads < 1 ? 1 : threads, hash_mb);
+        return 0;
+    }
+
+    Search search(threads < 1 ? 1 : threads, hash_mb);
+    TbResult result;
+
+    if(tablebase.probe(board.get_position(), board.get_turn(), result)) {
+        cout << "Tablebase: ";
+        if(result.outcome == TB_OUTCOME_DRAW) cout << "draw\n";
+        else cout << (result.outcome == TB_OUTCOME_WIN ? "win" : "loss")
+                  << " in " << result.plies << " plies\n";
+    }
+    if(book.size() > 0) print_book_moves(book, board);
+    search.set_tablebase(&tablebase);
+    Move best = search.think(board, limits, &listener);
+
+    if(best.is_null()) {
+        cout << "No legal move." << "\n";
+        return 0;
+    }
+    cout << "Best move: " << best.start() << best.end() << "\n";
+    if(limits.milliseconds > 0)
+        cout << "Overshoot: " << search.get_overshoot() << " ms\n";
+    return 0;
+}
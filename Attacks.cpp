@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Attacks.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Attacks.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+
+#include "Attacks.h"
+
+// TABLES
+// ======
+Bitboard knight_attack_table[64];
+Bitboard king_attack_table[64];
+Bitboard pawn_attack_table[2][64];
+Magic bishop_magics[64];
+Magic rook_magics[64];
+
+// Attacks of sliding pieces for all squares and all relevant occupancies.
+// Sizes are sums of 2^(bits in mask) over all squares.
+static Bitboard bishop_table[5248];
+static Bitboard rook_table[102400];
+
+static once_flag attacks_once;
+
+// Directions (dx, dy) of pieces.
+static const int KNIGHT_STEPS[8][2] = {
+    {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}
+};
+static const int KING_STEPS[8][2] = {
+    {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
+};
+static const int BISHOP_STEPS[4][2] = {
+    {1, 1}, {-1, 1}, {-1, -1}, {1, -1}
+};
+static const int ROOK_STEPS[4][2] = {
+    {1, 0}, {0, 1}, {-1, 0}, {0, -1}
+};
+static const int PAWN_STEPS[2][2][2] = {
+    {{-1, 1}, {1, 1}},    // WHITE takes up
+    {{-1, -1}, {1, -1}}   // BLACK takes down
+};
+
+// Bitboards of board edges.
+static const Bitboard ROW_1 = 0x00000000000000FFULL;
+static const Bitboard ROW_8 = 0xFF00000000000000ULL;
+static const Bitboard COLUMN_A = 0x0101010101010101ULL;
+static const Bitboard COLUMN_H = 0x8080808080808080ULL;
+
+// Function step targets.
+// Returns bitboard of squares that piece on "from" reaches with "n" steps
+// "steps". If "slides" is true, piece continues in each direction until it
+// leaves the board or hits occupied square (which is included).
+// This is slow way of computing attacks, used only to fill tables.
+static Bitboard step_targets(int from, const int steps[][2], int n,
+                             bool slides, Bitboard occupied) {
+    Bitboard targets = 0;
+    int from_x = from % 8;
+    int from_y = from / 8;
+
+    for(int i=0; i<n; i++) {
+        int x = from_x + steps[i][0];
+        int y = from_y + steps[i][1];
+
+        while(0 <= x && x < 8 && 0 <= y && y < 8) {
+            Bitboard bit = index_bit(8*y + x);
+
+            targets |= bit;
+            if(!slides || (occupied & bit)) break;
+            x += steps[i][0];
+            y += steps[i][1];
+        }
+    }
+    return targets;
+}
+
+// Magic numbers that work for every square, found once by "init_magics"
+// below. Search from random numbers takes about half a second, so it is
+// only used if number here stopped working (for example mask changed).
+static const Bitboard BISHOP_MAGIC_NUMBERS[64] = {
+    0x40106000A1160020ULL, 0x0020010250810120ULL, 0x2010010220280081ULL,
+    0x002806004050C040ULL, 0x0002021018000000ULL, 0x2001112010000400ULL,
+    0x0881010120218080ULL, 0x1030820110010500ULL, 0x0000120222042400ULL,
+    0x2000020404040044ULL, 0x8000480094208000ULL, 0x0003422A02000001ULL,
+    0x000A220210100040ULL, 0x8004820202226000ULL, 0x0018234854100800ULL,
+    0x0100004042101040ULL, 0x0004001004082820ULL, 0x0010000810010048ULL,
+    0x1014004208081300ULL, 0x2080818802044202ULL, 0x0040880C00A00100ULL,
+    0x0080400200522010ULL, 0x0001000188180B04ULL, 0x0080249202020204ULL,
+    0x1004400004100410ULL, 0x00013100A0022206ULL, 0x2148500001040080ULL,
+    0x4241080011004300ULL, 0x4020848004002000ULL, 0x10101380D1004100ULL,
+    0x0008004422020284ULL, 0x01010A1041008080ULL, 0x0808080400082121ULL,
+    0x0808080400082121ULL, 0x0091128200100C00ULL, 0x0202200802010104ULL,
+    0x8C0A020200440085ULL, 0x01A0008080B10040ULL, 0x0889520080122800ULL,
+    0x100902022202010AULL, 0x04081A0816002000ULL, 0x0000681208005000ULL,
+    0x8170840041008802ULL, 0x0A00004200810805ULL, 0x0830404408210100ULL,
+    0x2602208106006102ULL, 0x1048300680802628ULL, 0x2602208106006102ULL,
+    0x0602010120110040ULL, 0x0941010801043000ULL, 0x000040440A210428ULL,
+    0x0008240020880021ULL, 0x0400002012048200ULL, 0x00AC102001210220ULL,
+    0x0220021002009900ULL, 0x84440C080A013080ULL, 0x0001008044200440ULL,
+    0x0004C04410841000ULL, 0x2000500104011130ULL, 0x1A0C010011C20229ULL,
+    0x0044800112202200ULL, 0x0434804908100424ULL, 0x0300404822C08200ULL,
+    0x48081010008A2A80ULL
+};
+static const Bitboard ROOK_MAGIC_NUMBERS[64] = {
+    0x0A80004000801220ULL, 0x8040004010002008ULL, 0x2080200010008008ULL,
+    0x1100100008210004ULL, 0xC200209084020008ULL, 0x2100010004000208ULL,
+    0x0400081000822421ULL, 0x0200010422048844ULL, 0x0800800080400024ULL,
+    0x0001402000401000ULL, 0x3000801000802001ULL, 0x4400800800100083ULL,
+    0x0904802402480080ULL, 0x4040800400020080ULL, 0x0018808042000100ULL,
+    0x4040800080004100ULL, 0x0040048001458024ULL, 0x00A0004000205000ULL,
+    0x3100808010002000ULL, 0x4825010010000820ULL, 0x5004808008000401ULL,
+    0x2024818004000A00ULL, 0x0005808002000100ULL, 0x2100060004806104ULL,
+    0x0080400880008421ULL, 0x4062220600410280ULL, 0x010A004A00108022ULL,
+    0x0000100080080080ULL, 0x0021000500080010ULL, 0x0044000202001008ULL,
+    0x0000100400080102ULL, 0xC020128200040545ULL, 0x0080002000400040ULL,
+    0x0000804000802004ULL, 0x0000120022004080ULL, 0x010A386103001001ULL,
+    0x9010080080800400ULL, 0x8440020080800400ULL, 0x0004228824001001ULL,
+    0x000000490A000084ULL, 0x0080002000504000ULL, 0x200020005000C000ULL,
+    0x0012088020420010ULL, 0x0010010080080800ULL, 0x0085001008010004ULL,
+    0x0002000204008080ULL, 0x0040413002040008ULL, 0x0000304081020004ULL,
+    0x0080204000800080ULL, 0x3008804000290100ULL, 0x1010100080200080ULL,
+    0x2008100208028080ULL, 0x5000850800910100ULL, 0x8402019004680200ULL,
+    0x0120911028020400ULL, 0x0000008044010200ULL, 0x0020850200244012ULL,
+    0x0020850200244012ULL, 0x0000102001040841ULL, 0x140900040A100021ULL,
+    0x000200282410A102ULL, 0x000200282410A102ULL, 0x000200282410A102ULL,
+    0x4048240043802106ULL
+};
+
+// Function sparse random.
+// Xorshift64 generator, three numbers are ANDed together. Magic numbers with
+// few set bits are found much faster.
+static Bitboard sparse_random(Bitboard& state) {
+    Bitboard result = ~0ULL;
+
+    for(int i=0; i<3; i++) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        result &= state * 0x2545F4914F6CDD1DULL;
+    }
+    return result;
+}
+
+// Function init magics.
+// For every square: computes mask of relevant squares, enumerates all
+// subsets of the mask (all occupancies that matter) and computes attacks for
+// each of them the slow way. Then it tries magic numbers, first the known
+// one and then random ones, until it finds one that maps every occupancy to
+// index where either nothing or the same attacks were stored already.
+static void init_magics(Magic magics[], Bitboard table[],
+                        const int steps[][2], const Bitboard known[]) {
+    static Bitboard occupancies[4096], references[4096];
+    static int epoch[4096];
+    static int current = 0;
+    Bitboard state = 0x6A09E667F3BCC909ULL;
+    Bitboard* next = table;
+
+    for(int index=0; index<64; index++) {
+        Magic& m = magics[index];
+        Bitboard edges, subset;
+        int size;
+
+        edges = ((ROW_1 | ROW_8) & ~(ROW_1 << (8 * (index / 8))))
+                | ((COLUMN_A | COLUMN_H) & ~(COLUMN_A << (index % 8)));
+        m.mask = step_targets(index, steps, 4, true, 0) & ~edges;
+        m.shift = 64 - pop_count(m.mask);
+        m.attacks = next;
+
+        // Carry-Rippler trick enumerates all subsets of the mask.
+        size = 0;
+        subset = 0;
+        do {
+            occupancies[size] = subset;
+            references[size] = step_targets(index, steps, 4, true, subset);
+            size++;
+            subset = (subset - m.mask) & m.mask;
+        } while(subset);
+        next += size;
+
+        // With PEXT the index is always perfect, so the first try succeeds.
+        m.magic = known[index];
+        for(bool found = false; !found; ) {
+            while(pop_count((m.magic * m.mask) >> 56) < 6)
+                m.magic = sparse_random(state);
+
+            current++;
+            found = true;
+            for(int i=0; i<size; i++) {
+                unsigned slot = m.index(occupancies[i]);
+
+                if(epoch[slot] < current) {
+                    epoch[slot] = current;
+                    m.attacks[slot] = references[i];
+                }
+                else if(m.attacks[slot] != references[i]) {
+                    found = false;
+                    m.magic = 0;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Function fill tables.
+static void fill_tables() {
+    for(int index=0; index<64; index++) {
+        knight_attack_table[index] = step_targets(index, KNIGHT_STEPS, 8,
+                                                  false, 0);
+        king_attack_table[index] = step_targets(index, KING_STEPS, 8,
+                                                false, 0);
+        pawn_attack_table[WHITE][index] = step_targets(index,
+                                                       PAWN_STEPS[WHITE], 2,
+                                                       false, 0);
+        pawn_attack_table[BLACK][index] = step_targets(index,
+                                                       PAWN_STEPS[BLACK], 2,
+                                                       false, 0);
+    }
+    init_magics(bishop_magics, bishop_table, BISHOP_STEPS,
+                BISHOP_MAGIC_NUMBERS);
+    init_magics(rook_magics, rook_table, ROOK_STEPS, ROOK_MAGIC_NUMBERS);
+}
+
+// Function init attacks.
+void init_attacks() {
+    call_once(attacks_once, fill_tables);
+}
+
+// Function is attacked.
+// Instead of looking from every enemy piece towards the square, we look from
+// the square: if knight on "index" would attack enemy knight, enemy knight
+// attacks "index". The same holds for all pieces; for pawns we use attacks of
+// pawn of the other color.
+bool is_attacked(const Position& position, int index, Color by) {
+    Bitboard occupied = position.get_occupied();
+    Bitboard queens = position.get_pieces(by, QUEEN);
+
+    return (pawn_attacks(inverse_color(by), index)
+            & position.get_pieces(by, PAWN))
+        || (knight_attacks(index) & position.get_pieces(by, KNIGHT))
+        || (king_attacks(index) & position.get_pieces(by, KING))
+        || (bishop_attacks(index, occupied)
+            & (position.get_pieces(by, BISHOP) | queens))
+        || (rook_attacks(index, occupied)
+            & (position.get_pieces(by, ROOK) | queens));
+}
+
+// Function attackers to.
+// Same trick as "is_attacked", but for both colors at once.
+Bitboard attackers_to(const Position& position, int index, Bitboard occupied) {
+    Bitboard bishops = position.get_pieces(WHITE, BISHOP)
+                       | position.get_pieces(BLACK, BISHOP)
+                       | position.get_pieces(WHITE, QUEEN)
+                       | position.get_pieces(BLACK, QUEEN);
+    Bitboard rooks = position.get_pieces(WHITE, ROOK)
+                     | position.get_pieces(BLACK, ROOK)
+                     | position.get_pieces(WHITE, QUEEN)
+                     | position.get_pieces(BLACK, QUEEN);
+
+    return (pawn_attacks(BLACK, index) & position.get_pieces(WHITE, PAWN))
+        | (pawn_attacks(WHITE, index) & position.get_pieces(BLACK, PAWN))
+        | (knight_attacks(index) & (position.get_pieces(WHITE, KNIGHT)
+                                    | position.get_pieces(BLACK, KNIGHT)))
+        | (king_attacks(index) & (position.get_pieces(WHITE, KING)
+                                  | position.get_pieces(BLACK, KING)))
+        | (bishop_attacks(index, occupied) & bishops)
+        | (rook_attacks(index, occupied) & rooks);
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Attacks.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for precomputed attack tables. For every square
+//              they hold bitboard of squares that knight, king or pawn
+//              standing there attacks. Attacks of sliding pieces (bishop,
+//              rook, queen) depend on other pieces on the board, so they are
+//              looked up with "magic" hashing of occupancy: relevant
+//              occupancy is multiplied by magic number and top bits of the
+//              product are index in table of attacks. If compiler is told
+//              that CPU has BMI2 instructions (g++ -mbmi2), the index is
+//              computed with PEXT instead of multiplication.
+//
+//              Tables are filled by "init_attacks", which must be called
+//              before any other function in this file. ChessBoard calls it
+//              in its constructor. After that tables are only read, so they
+//              can be shared by all threads.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ATTACKS_H_
+#define ATTACKS_H_
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "Bitboard.h"
+#include "Position.h"
+
+
+// STRUCT: Magic
+// =============
+// Everything needed to look up attacks of sliding piece on one square.
+// "mask" holds squares whose occupancy changes attacks (edges of the board
+// are excluded, as piece always attacks them when it gets there). "attacks"
+// points to the part of big table that belongs to this square.
+struct Magic {
+    Bitboard mask;
+    Bitboard magic;
+    Bitboard* attacks;
+    int shift;
+
+    unsigned index(Bitboard occupied) const;
+};
+
+// TABLES
+// ======
+extern Bitboard knight_attack_table[64];
+extern Bitboard king_attack_table[64];
+extern Bitboard pawn_attack_table[2][64];  // pawn_attack_table[color][index]
+extern Magic bishop_magics[64];
+extern Magic rook_magics[64];
+
+// Function init attacks fills all tables. It is safe to call it more than
+// once (and from more threads); tables are filled only the first time.
+void init_attacks();
+
+// Function is attacked returns true if any piece of Color "by" attacks
+// square "index" in "position".
+bool is_attacked(const Position& position, int index, Color by);
+
+// Function attackers to returns bitboard of pieces of both colors that
+// attack square "index", as if only squares of "occupied" were occupied.
+// Pieces that are not in "occupied" are included too; caller removes them
+// (refer to See.cpp).
+Bitboard attackers_to(const Position& position, int index, Bitboard occupied);
+
+// INLINE FUNCTIONS
+// ================
+// Lookups are done for every generated move and every check test, so they
+// are inline.
+
+inline unsigned Magic::index(Bitboard occupied) const {
+#ifdef __BMI2__
+    return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+    return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+}
+
+inline Bitboard knight_attacks(int index) {
+    return knight_attack_table[index];
+}
+
+inline Bitboard king_attacks(int index) {
+    return king_attack_table[index];
+}
+
+// Squares attacked by pawn of Color "color" standing on square "index".
+inline Bitboard pawn_attacks(Color color, int index) {
+    return pawn_attack_table[color][index];
+}
+
+inline Bitboard bishop_attacks(int index, Bitboard occupied) {
+    const Magic& m = bishop_magics[index];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard rook_attacks(int index, Bitboard occupied) {
+    const Magic& m = rook_magics[index];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard queen_attacks(int index, Bitboard occupied) {
+    return bishop_attacks(index, occupied) | rook_attacks(index, occupied);
+}
+
+// Attacks of piece of PieceType "type" (not pawn) on square "index".
+inline Bitboard piece_attacks(PieceType type, int index, Bitboard occupied) {
+    switch(type) {
+        case KNIGHT: return knight_attacks(index);
+        case BISHOP: return bishop_attacks(index, occupied);
+        case ROOK: return rook_attacks(index, occupied);
+        case QUEEN: return queen_attacks(index, occupied);
+        case KING: return king_attacks(index);
+        default: return 0;
+    }
+}
+
+
+#endif // ATTACKS_H_
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Bitboard.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for type Bitboard and few helper functions that
+//              make work with bitboards easier. Bitboard is 64-bit mask in
+//              which every bit represents one square of chess board. Bit with
+//              index 8*y + x represents Square(x, y). That means that A1 is
+//              bit 0, H1 is bit 7 and H8 is bit 63.
+//              All functions are inline, as they are used in every move.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BITBOARD_H_
+#define BITBOARD_H_
+
+#include "Square.h"
+
+
+// TYPEDEFs
+// ========
+typedef unsigned long long Bitboard;
+
+// Function that converts Square "square" to bit index (0-63).
+inline int square_index(Square square) {
+    return 8*square.y + square.x;
+}
+
+// Function that converts bit index (0-63) back to Square.
+// NOTE: this is not the same as Square(int) constructor, which iterates
+// board column by column.
+inline Square index_square(int index) {
+    return Square(index % 8, index / 8);
+}
+
+// Function that returns bitboard with only bit "index" set.
+inline Bitboard index_bit(int index) {
+    return 1ULL << index;
+}
+
+// Function that counts how many bits are set in bitboard "b".
+inline int pop_count(Bitboard b) {
+    return __builtin_popcountll(b);
+}
+
+// Function that returns index of lowest set bit in "b".
+// NOTE: "b" must not be empty.
+inline int first_index(Bitboard b) {
+    return __builtin_ctzll(b);
+}
+
+// Function that returns index of lowest set bit in "b" and clears that bit.
+// It is used to iterate bitboard: while(b) { int i = pop_first_index(b); }
+inline int pop_first_index(Bitboard& b) {
+    int index = __builtin_ctzll(b);
+    b &= b - 1;
+    return index;
+}
+
+
+#endif // BITBOARD_H_
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Book.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for opening book. Book is file in Polyglot format
+//              (".bin"): array of 16-byte entries, sorted by key of
+//              position, each with one move and its weight. File is mapped
+//              (refer to MappedFile.h) and position is found with binary
+//              search, so probe reads only a few entries and needs no
+//              memory of its own.
+//
+//              Entry layout (big endian):
+//                  key (8 bytes), move (2 bytes), weight (2 bytes),
+//                  learn (4 bytes, not used).
+//              Move: to file in bits 0-2, to row in bits 3-5, from file in
+//              bits 6-8, from row in bits 9-11, promotion in bits 12-14.
+//              Square is 8 * row + file, as index of this engine.
+//
+//              Key is Polyglot hash: XOR of Polyglot's random numbers for
+//              every piece on its square, for every castling right and for
+//              white to move, so books of other programs can be probed and
+//              books of chess-book (refer to BookGen.cpp) can be used by
+//              them. This engine has no castling, so castling right is
+//              assumed while king and rook stand on their starting squares.
+//              En passant is never possible, so its numbers are not used.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOK_H_
+#define BOOK_H_
+
+#include <cstddef>
+
+#include "Position.h"
+#include "Move.h"
+#include "Zobrist.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+
+// File format.
+const int BOOK_ENTRY_SIZE = 16;
+
+// Random numbers of key: 12 * 64 for pieces (Polyglot kind is
+// 2 * piece type + 1 for white), 4 for castling rights, 8 for en passant
+// file and 1 for white to move.
+const int BOOK_RANDOM_COUNT = 781;
+const int BOOK_RANDOM_CASTLING = 768;
+const int BOOK_RANDOM_TURN = 780;
+
+// Most moves of one position returned by "find_moves". Book rarely has
+// more than a dozen.
+const int BOOK_MAX_MOVES = 64;
+
+// STRUCT: BookMove
+// ================
+// Move found in book and its weight (bigger is played more often).
+struct BookMove {
+    Move move;
+    int weight;
+};
+
+// Functions book move and book move data convert between move of book entry
+// and Move. Moves with promotion can't be played in this engine, so they
+// give "no move".
+Move book_move(unsigned short data);
+unsigned short book_move_data(Move move);
+
+// Function book key computes Polyglot key of "position" with "turn" on
+// turn.
+Key book_key(const Position& position, Color turn);
+
+// CLASS: Book
+// ===========
+// Usage:
+//     Book book;
+//     if(book.open("book.bin")) {
+//         Move move = book.pick_move(board.get_position(), board.get_turn(),
+//                                    random);
+//         if(!move.is_null()) ...
+//     }
+// Book is only read, so it can be probed by many threads at once.
+class Book {
+private:
+    MappedFile file;
+    const unsigned char* entries;
+    size_t count;
+
+    Key entry_key(size_t index) const;
+    size_t lower_bound(Key key) const;
+
+public:
+    Book();
+
+    Book(const Book&) = delete;
+    Book& operator=(const Book&) = delete;
+
+    // Method open maps book "path". Returns false if file can't be opened
+    // or its size isn't multiple of entry size.
+    bool open(const char* path);
+    void close();
+
+    // Number of entries (0 if no book is open).
+    size_t size() const;
+
+    // Method find moves writes moves of position (at most "max") to
+    // "moves" and returns their number. Only moves that are legal in
+    // position are returned, so entry of other position with the same key
+    // is never played. Attack tables must be initialized (refer to
+    // Attacks.h; ChessBoard does it).
+    int find_moves(const Position& position, Color turn, BookMove moves[],
+                   int max) const;
+
+    // Method pick move chooses one of book moves, each with probability
+    // weight / sum of weights, by number "random" (any 64-bit value).
+    // Returns "no move" if position is not in book.
+    Move pick_move(const Position& position, Color turn,
+                   unsigned long long random) const;
+};
+
+
+#endif // BOOK_H_
@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: BookGen.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Opening book generator. It reads games from PGN files and
+//              writes book in Polyglot format (refer to Book.h) with moves
+//              played in first plies of the games.
+//
+//              Usage: chess-book [-plies N] [-min N] BOOK FILE.pgn ...
+//              Moves of first N plies (default 16) of every game are
+//              counted; move is put in book if it was played at least -min
+//              times (default 1) in the same position, with number of games
+//              as its weight.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+using namespace std;
+
+#include "Book.h"
+#include "ChessBoard.hpp"
+#include "PgnReader.h"
+#include "MappedFile.h"
+
+// Defaults of options.
+static const int DEFAULT_PLIES = 16;
+static const int DEFAULT_MIN_GAMES = 1;
+
+// Biggest weight that fits in entry.
+static const unsigned long long MAX_WEIGHT = 65535;
+
+// STRUCT: BookEntry
+// =================
+struct BookEntry {
+    Key key;
+    unsigned short move;
+    unsigned long long games;
+};
+
+// Function entry order.
+// Entries are sorted by key and moves of one position by weight (most
+// played first), as in Polyglot books.
+static bool entry_order(const BookEntry& a, const BookEntry& b) {
+    if(a.key != b.key) return a.key < b.key;
+    return a.games > b.games;
+}
+
+// CLASS: BookCollector
+// ====================
+// Counts moves of first plies of games. It keeps its own copy of position
+// before each move, as visitor sees board only after move is played.
+class BookCollector: public PgnVisitor {
+private:
+    int max_plies;
+    Position position;
+    Color turn;
+    int ply;
+    map<pair<Key, unsigned short>, unsigned long long> counts;
+
+public:
+    BookCollector(int _max_plies);
+
+    void start(const ChessBoard& board);
+    void move(const MoveResult& result);
+
+    // Method get entries returns moves played at least "min_games" times.
+    vector<BookEntry> get_entries(unsigned long long min_games) const;
+};
+
+// Constructor.
+BookCollector::BookCollector(int _max_plies) : max_plies(_max_plies) {
+    turn = WHITE;
+    ply = 0;
+}
+
+// PUBLIC METHOD: start
+// ====================
+// Reader calls it after tags of game, so game set up with FEN tag starts
+// from its own position.
+void BookCollector::start(const ChessBoard& board) {
+    position = board.get_position();
+    turn = board.get_turn();
+    ply = 0;
+}
+
+// PUBLIC METHOD: move
+// ===================
+void BookCollector::move(const MoveResult& result) {
+    Move move(result.start, result.end);
+
+    if(ply >= max_plies) return;
+    counts[make_pair(book_key(position, turn), book_move_data(move))]++;
+
+    if(!position.is_empty(move.to())) position.remove_piece(move.to());
+    position.remove_piece(move.from());
+    position.put_piece(turn, piece_type(result.piece), move.to());
+    turn = inverse_color(turn);
+    ply++;
+}
+
+// PUBLIC METHOD: get entries
+// ==========================
+vector<BookEntry> BookCollector::get_entries(
+        unsigned long long min_games) const {
+    vector<BookEntry> entries;
+    map<pair<Key, unsigned short>, unsigned long long>::const_iterator it;
+
+    for(it=counts.begin(); it!=counts.end(); it++) {
+        if(it->second < min_games) continue;
+
+        BookEntry entry;
+        entry.key = it->first.first;
+        entry.move = it->first.second;
+        entry.games = it->second;
+        entries.push_back(entry);
+    }
+    sort(entries.begin(), entries.end(), entry_order);
+    return entries;
+}
+
+// Function write big endian.
+static void write_big_endian(char* data, unsigned long long value,
+                             int bytes) {
+    for(int i=bytes-1; i>=0; i--) {
+        data[i] = static_cast<char>(value & 255);
+        value >>= 8;
+    }
+}
+
+// Function write book.
+// If some move was played more than MAX_WEIGHT times, all weights are
+// scaled down (but never to 0).
+static bool write_book(const string& path, const vector<BookEntry>& entries) {
+    ofstream file(path, ios::binary);
+    unsigned long long most = 0;
+
+    for(size_t i=0; i<entries.size(); i++)
+        most = max(most, entries[i].games);
+
+    for(size_t i=0; i<entries.size(); i++) {
+        char data[BOOK_ENTRY_SIZE];
+        unsigned long long weight = entries[i].games;
+
+        if(most > MAX_WEIGHT) weight = max(1ULL, weight * MAX_WEIGHT / most);
+        write_big_endian(data, entries[i].key, 8);
+        write_big_endian(data + 8, entries[i].move, 2);
+        write_big_endian(data + 10, weight, 2);
+        write_big_endian(data + 12, 0, 4);
+        file.write(data, BOOK_ENTRY_SIZE);
+    }
+    return static_cast<bool>(file);
+}
+
+// Function print usage.
+static void print_usage() {
+    cerr << "Usage: chess-book [-plies N] [-min N] BOOK FILE.pgn ..." << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int plies = DEFAULT_PLIES, min_games = DEFAULT_MIN_GAMES;
+    string book_path;
+    vector<string> inputs;
+    ChessBoard board(NULL);
+    PgnGame game;
+    int games = 0;
+
+    for(int i=1; i<argc; i++) {
+        string arg = argv[i];
+
+        if(arg == "-plies" && i+1 < argc) {
+            plies = atoi(argv[++i]);
+        }
+        else if(arg == "-min" && i+1 < argc) {
+            min_games = atoi(argv[++i]);
+            if(min_games < 1) min_games = 1;
+        }
+        else if(book_path.empty()) {
+            book_path = arg;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if(book_path.empty() || inputs.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    BookCollector collector(plies);
+    for(size_t i=0; i<inputs.size(); i++) {
+        MappedFile file;
+
+        if(!file.open(inputs[i].c_str())) {
+            cerr << "Can't open " << inputs[i] << "!" << endl;
+            return 1;
+        }
+
+        PgnReader reader(file.get_view());
+        while(reader.read_game(board, game, &collector))
+            games++;
+    }
+
+    vector<BookEntry> entries = collector.get_entries(min_games);
+    if(!write_book(book_path, entries)) {
+        cerr << "Can't write " << book_path << "!" << endl;
+        return 1;
+    }
+    cout << "Games: " << games << "\n";
+    cout << "Entries: " << entries.size() << "\n";
+    return 0;
+}
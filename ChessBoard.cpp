@@ -6,6 +6,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ChessBoard.hpp"
+#include "MoveGen.h"
+#include "Attacks.h"
 
 // Function dif.
 int dif(int x1, int x2) {
@@ -14,37 +16,174 @@ int dif(int x1, int x2) {
 }
 
 // Basic constructor. 
+// Board reports to console, as it always did.
 ChessBoard::ChessBoard() {
+    init_attacks();
+    sink = console_event_sink();
     turn = WHITE;
-	set_board_null();
 	resetBoard();
 }
 
-// Copy constructor.
-// It utilizes "clone" method in ChessPiece.h.
-ChessBoard::ChessBoard(ChessBoard& old_board) {
-    // Next loop copies all chess pieces from old to new board.
-    for(int i=0; i<64; i++) {
-        if(old_board.get_square(Square(i)) == NULL)
-            get_square(Square(i)) = NULL;
-        else
-            get_square(Square(i)) = old_board.get_square(Square(i))->clone();
-    }
-    game_finished = old_board.game_finished;
-    turn = old_board.turn;
+// Constructor with event sink.
+// If "new_sink" is NULL, board is silent.
+ChessBoard::ChessBoard(ChessEventSink* new_sink) {
+    init_attacks();
+    sink = new_sink;
+    turn = WHITE;
+	resetBoard();
 }
 
-// Destructor.
-ChessBoard::~ChessBoard() {
-    // Deliberately empty.   
-}
+// Board holds only values (no pointers), so copy constructor, assignment
+// and destructor are generated by compiler and copy is plain copy of memory.
+static_assert(is_trivially_copyable<ChessBoard>::value,
+              "ChessBoard must stay trivially copyable");
 
 // PUBLIC METHOD: resetBoard
 // =========================
 void ChessBoard::resetBoard() {
     game_finished = false;
     reset_board();
-    cout << "A new chess game is started!" << endl;
+    if(sink != NULL)
+        sink->new_game();
+}
+
+// Function fen piece.
+// Converts FEN letter to piece code ("P" is white pawn, "p" black pawn).
+// Returns NO_PIECE if "letter" isn't piece letter.
+static Piece fen_piece(char letter) {
+    for(int piece=0; piece<PIECE_CODES; piece++) {
+        if(PIECE_SYMBOLS[piece] == ' ') continue;
+
+        char symbol = PIECE_SYMBOLS[piece];
+        if(piece_color(static_cast<Piece>(piece)) == BLACK)
+            symbol = symbol - 'A' + 'a';
+        if(symbol == letter) return static_cast<Piece>(piece);
+    }
+    return NO_PIECE;
+}
+
+// Function read fen number.
+// Skips spaces and reads number at position "i" of "fen". Returns false
+// (and leaves "value" as it is) if there is no number.
+static bool read_fen_number(string_view fen, size_t& i, int& value) {
+    int number = 0;
+
+    while(i < fen.size() && fen[i] == ' ') i++;
+    if(i >= fen.size() || fen[i] < '0' || '9' < fen[i]) return false;
+    while(i < fen.size() && '0' <= fen[i] && fen[i] <= '9')
+        number = 10 * number + (fen[i++] - '0');
+    value = number;
+    return true;
+}
+
+// PUBLIC METHOD: from fen
+// =======================
+// Placement is read into separate Position, so board is left untouched if
+// FEN is wrong. Castling and en passant fields are not needed by this
+// engine and are skipped.
+bool ChessBoard::from_fen(string_view fen) {
+    Position placement;
+    size_t i = 0;
+    int kings[2] = {0, 0};
+    int clock = 0, move_number = 1;
+    Color fen_turn;
+
+    placement.clear();
+    for(int y=7; y>=0; y--) {
+        int x = 0;
+
+        while(i < fen.size() && fen[i] != '/' && fen[i] != ' ') {
+            char c = fen[i++];
+
+            if('1' <= c && c <= '8') {
+                x += c - '0';
+                continue;
+            }
+
+            Piece piece = fen_piece(c);
+            if(piece == NO_PIECE || x > 7) return false;
+            placement.put_piece(piece_color(piece), piece_type(piece),
+                                8*y + x);
+            if(piece_type(piece) == KING) kings[piece_color(piece)]++;
+            x++;
+        }
+        if(x != 8) return false;
+        if(y > 0) {
+            if(i >= fen.size() || fen[i] != '/') return false;
+            i++;
+        }
+    }
+    if(kings[WHITE] != 1 || kings[BLACK] != 1) return false;
+
+    while(i < fen.size() && fen[i] == ' ') i++;
+    if(i >= fen.size()) return false;
+    if(fen[i] == 'w') fen_turn = WHITE;
+    else if(fen[i] == 'b') fen_turn = BLACK;
+    else return false;
+    i++;
+
+    for(int field=0; field<2; field++) {
+        while(i < fen.size() && fen[i] == ' ') i++;
+        while(i < fen.size() && fen[i] != ' ') i++;
+    }
+    if(read_fen_number(fen, i, clock))
+        read_fen_number(fen, i, move_number);
+    if(move_number < 1) move_number = 1;
+
+    // Player who just moved can't be in chess.
+    int king = first_index(placement.get_pieces(inverse_color(fen_turn),
+                                                KING));
+    if(is_attacked(placement, king, fen_turn)) return false;
+
+    position = placement;
+    turn = fen_turn;
+    key = compute_key();
+    eval = compute_eval(position);
+    locate_kings();
+    clear_history(clock, 2 * (move_number - 1) + (turn == BLACK ? 1 : 0));
+    status_valid = false;
+    game_finished = (game_status().moves.size() == 0) || is_automatic_draw();
+    return true;
+}
+
+// PUBLIC METHOD: to fen
+// =====================
+// Castling and en passant don't exist in this engine, so they are always
+// "-".
+string ChessBoard::to_fen() const {
+    string fen;
+
+    for(int y=7; y>=0; y--) {
+        int empty = 0;
+
+        for(int x=0; x<8; x++) {
+            Piece piece = position.piece_at(8*y + x);
+
+            if(piece == NO_PIECE) {
+                empty++;
+                continue;
+            }
+            if(empty > 0) fen += static_cast<char>('0' + empty);
+            empty = 0;
+
+            char symbol = PIECE_SYMBOLS[piece];
+            if(piece_color(piece) == BLACK) symbol = symbol - 'A' + 'a';
+            fen += symbol;
+        }
+        if(empty > 0) fen += static_cast<char>('0' + empty);
+        if(y > 0) fen += '/';
+    }
+
+    fen += (turn == WHITE ? " w" : " b");
+    fen += " - - " + to_string(halfmove_clock);
+    fen += " " + to_string(1 + (start_ply + game_ply) / 2);
+    return fen;
+}
+
+// PUBLIC METHOD: set event sink
+// =============================
+void ChessBoard::set_event_sink(ChessEventSink* new_sink) {
+    sink = new_sink;
 }
 
 // PUBLIC METHOD: print board
@@ -89,17 +228,20 @@ void ChessBoard::print_last_line() const {
 
 // Method: print square
 void ChessBoard::print_square(int i, int j) const {
-    if(board[i][j] == NULL)
+    Piece piece = get_square(Square(i, j));
+
+    if(piece == NO_PIECE)
         cout << "   ";
     else
-        board[i][j]->print_ascii(cout);
+        print_piece_ascii(cout, piece);
 }
 
 // Method: get square
-// Get_square function takes square as input and returns chess piece
+// Get_square function takes square as input and returns code of chess piece
 // at that square. This function is used to simplify access.
-ChessPiecePtr& ChessBoard::get_square(Square square) {
-    return board[square.x][square.y];
+// If square is empty it returns NO_PIECE.
+Piece ChessBoard::get_square(Square square) const {
+    return position.piece_at(square_index(square));
 }
 
 // Method: print equals line.
@@ -110,71 +252,38 @@ void ChessBoard::print_equals_line(int d) const {
     cout << endl;
 }
 
-// Method: print move
-// This method is used to print out each move players do.
-void ChessBoard::print_move(Square start, Square end) {
-    if(get_square(start) == NULL) {  // Starting square shouldn't be NULL
-        cerr << "ERROR";             // we just make double check here.
-        return;
-    }
-
-    get_square(start)->print_name(cout);
-    cout << " moves from " << start << " to " << end;
-    if(get_square(end) != NULL) {
-        cout << " taking ";
-        get_square(end)->print_name(cout);
-    }
-    cout << endl;
-}
-
-// Method: print game state
-// This method prints current state of game, e. g: "White's in chess".
-// Game state always refers to state of game that was valid entire game.
-// It also refers to just before a player does move.
-void ChessBoard::print_game_state() {
-    bool has_move, in_chess;
-
-    has_move = has_valid_move(turn);
-    in_chess = is_in_chess(turn);
-
-    // If current player to move is either in check or has no move.
-    // Game will end.
-    if(!has_move || in_chess) {
-        cout << color_to_string(turn) << " is in ";
-        if(!has_move && in_chess) cout << "checkmate";
-        else if(!has_move) cout << "stellmate";
-        else cout << "check";
-        cout << endl;
-    }
-}
-
 // Method: reset board
 void ChessBoard::reset_board() {
     clear_board();
-    set_board_null();
     set_starting_set(WHITE);
     set_starting_set(BLACK);
 	turn = WHITE;
+    key = compute_key();
+    eval = compute_eval(position);
+    locate_kings();
+    clear_history(0, 0);
+    status_valid = false;
+}
+
+// Method: clear history
+// Forgets all keys; position was set without moves that led to it.
+void ChessBoard::clear_history(int clock, int ply) {
+    game_ply = 0;
+    start_ply = ply;
+    halfmove_clock = clock;
 }
 
 // Method: clear board
 void ChessBoard::clear_board() {
-    for(int i=0; i<64; i++) {
-        delete_square(Square(i));
-    }
+    position.clear();
 }
 
 // Method: delete square
 void ChessBoard::delete_square(Square square) {
-    if(get_square(square) != NULL)
-        delete get_square(square);
-    get_square(square) = NULL;
-}
+    int index = square_index(square);
 
-// Method: set board null
-void ChessBoard::set_board_null() {
-    for(int i=0; i<64; i++)
-        get_square(Square(i)) = NULL;
+    if(!position.is_empty(index))
+        position.remove_piece(index);
 }
 
 // Method: set starting set
@@ -186,166 +295,215 @@ void ChessBoard::set_starting_set(Color color) {
     king_position = 4;
 
     for(int i=0; i<8; i++)
-        board[i][second_line] = new Pawn(color);
-
-    board[0][first_line] = new Rook(color);
-    board[7][first_line] = new Rook(color);
-
-    board[1][first_line] = new Knight(color);
-    board[6][first_line] = new Knight(color);
-
-    board[2][first_line] = new Bishop(color);
-    board[5][first_line] = new Bishop(color);
-
-    board[king_position][first_line] = new King(color);
-    board[7-king_position][first_line] = new Queen(color);
-}
-
-// Method: has_valid_move
-// This is the bottleneck method, but it still manages to be fast enough for
-// us to use it. It simply bruteforces entire board. For more explanation
-// refer to ChessBoard class description.
-bool ChessBoard::has_valid_move(Color color) {
-    for(int i=0; i<64; i++) {
-        if(get_square(Square(i)) != NULL
-           && get_square(Square(i))->get_color() == color)
-        {
-            for(int j=0; j<64; j++) {
-                ChessBoard new_board(*this);
-                if(new_board.valid_move(Square(i), Square(j), color, false)) {
-                    return true;
-                }
-            }
-        }
+        position.put_piece(color, PAWN, square_index(Square(i, second_line)));
+
+    position.put_piece(color, ROOK, square_index(Square(0, first_line)));
+    position.put_piece(color, ROOK, square_index(Square(7, first_line)));
+
+    position.put_piece(color, KNIGHT, square_index(Square(1, first_line)));
+    position.put_piece(color, KNIGHT, square_index(Square(6, first_line)));
+
+    position.put_piece(color, BISHOP, square_index(Square(2, first_line)));
+    position.put_piece(color, BISHOP, square_index(Square(5, first_line)));
+
+    position.put_piece(color, KING,
+                       square_index(Square(king_position, first_line)));
+    position.put_piece(color, QUEEN,
+                       square_index(Square(7-king_position, first_line)));
+}
+
+// Method: compute status
+// Generates moves of player on turn and keeps those that don't leave him in
+// chess. For more explanation refer to ChessBoard class description.
+// NOTE: making moves clears "status_valid", so it is set only at the end.
+void ChessBoard::compute_status() {
+    MoveList candidates;
+    bool has_move;
+
+    status.moves.clear();
+    generate_moves(position, turn, candidates);
+    for(int i=0; i<candidates.size(); i++) {
+        if(ok_end_position(candidates[i].start(), candidates[i].end(), turn))
+            status.moves.add(candidates[i]);
     }
-    return false;
+
+    status.in_chess = is_in_chess(turn);
+    has_move = (status.moves.size() > 0);
+    if(!has_move && status.in_chess) status.state = MOVE_CHECKMATE;
+    else if(!has_move) status.state = MOVE_STALEMATE;
+    else if(status.in_chess) status.state = MOVE_CHECK;
+    else status.state = MOVE_OK;
+
+    status_valid = true;
 }
 
-// Method: is in chess
-// Tells if player of Color "color" is in chess.
-// This function iterates entire board, searching for "inverse_color("color")"
-// piece that could move to "color" king.
-bool ChessBoard::is_in_chess(Color color) {
-    Square king_square;
-    Color opo_color;
+// PUBLIC METHOD: game status
+// ==========================
+const GameStatus& ChessBoard::game_status() {
+    if(!status_valid)
+        compute_status();
+    return status;
+}
 
-    king_square = find_king(color);
-    opo_color = inverse_color(color);
+// PUBLIC METHOD: legal moves
+// ==========================
+// If status is known, moves are copied from it. Otherwise they are computed
+// straight in "moves", without touching status, as search and perft call
+// this method in every position they visit and never use the rest of it.
+void ChessBoard::legal_moves(MoveList& moves) {
+    MoveList candidates;
 
-    for(int i=0; i<8; i++) {
-        for(int j=0; j<8; j++) {
-            if(board[i][j] != NULL && board[i][j]->get_color() == opo_color) {
-                if(can_move(Square(i,j), king_square, false))
-                    return true;
-            }
-        }
+    moves.clear();
+    if(game_finished) return;
+
+    if(status_valid) {
+        moves = status.moves;
+        return;
+    }
+
+    generate_moves(position, turn, candidates);
+    for(int i=0; i<candidates.size(); i++) {
+        if(ok_end_position(candidates[i].start(), candidates[i].end(), turn))
+            moves.add(candidates[i]);
     }
-    return false;
+}
+
+// PUBLIC METHOD: is in chess
+// ==========================
+// Tells if player of Color "color" is in chess.
+// Square of "color" king is looked up in attack tables (refer to Attacks.h).
+bool ChessBoard::is_in_chess(Color color) {
+    return is_attacked(position, king_squares[color], inverse_color(color));
 }
 
 // Method: ok end position
 // Method that checks if move from Square start to Square end won't put us in 
-// chess. It creates new board and simulates move on it.
+// chess. It makes move on this board, checks for chess and takes move back.
 // NOTE: this method doesn't deal with invalid input.
-bool ChessBoard::ok_end_position(Square start, Square end,
-                                 Color color, bool verbose) {
-
-    ChessBoard new_board(*this);
-    new_board.make_move(start, end);
-    if(new_board.is_in_chess(color)) {
-        if(verbose)
-            cerr << "This move leaves you in check!" << endl;
-        return false;
-    }
-    return true;
+bool ChessBoard::ok_end_position(Square start, Square end, Color color) {
+    MoveUndo undo;
+    bool in_chess;
+
+    make_move(start, end, undo);
+    in_chess = is_in_chess(color);
+    unmake_move(start, end, undo);
+
+    return !in_chess;
 }
 
-// PUBLIC METHOD: enter move
-// =========================
+// PUBLIC METHOD: submit move
+// ==========================
 // Checks if input is valid and converts it in format of class Square.
-// Execution continues on enter_move(Square, Square).
-bool ChessBoard::submitMove(string start, string end) {
+// Execution continues on enter_move(Square, Square). Result is reported to
+// event sink.
+bool ChessBoard::submitMove(string_view start, string_view end) {
     bool conversion;
-    Square start_square, end_square;
-
-    if(game_finished) return false;  // If game is over you need to reset game.
+    Square start_square(0, 0), end_square(0, 0);
+    MoveResult result;
 
     conversion = string_to_square(start, start_square);
     conversion &= string_to_square(end, end_square);
 
-    if(!conversion) {
-        cerr << "Invalid input!" << endl;
-        return false;
+    if(game_finished)  // If game is over you need to reset game.
+        result = new_result(MOVE_GAME_FINISHED, start_square, end_square);
+    else if(!conversion)
+        result = new_result(MOVE_INVALID_INPUT, start_square, end_square);
+    else
+        result = enter_move(start_square, end_square);
+
+    if(sink != NULL) {
+        if(move_accepted(result.status))
+            sink->move_made(result);
+        else
+            sink->move_rejected(result);
     }
+    return move_accepted(result.status);
+}
 
-    return enter_move(start_square, end_square);
+// PUBLIC METHOD: submit move
+// ==========================
+// Silent version: nothing is reported, result is returned.
+MoveResult ChessBoard::submitMove(Square start, Square end) {
+    if(game_finished)
+        return new_result(MOVE_GAME_FINISHED, start, end);
+    return enter_move(start, end);
+}
+
+// Method: new result
+// Creates result of move from "start" to "end" with given status. Moved
+// piece is read from board, captured piece is filled by enter_move.
+MoveResult ChessBoard::new_result(MoveStatus status, Square start,
+                                  Square end) {
+    MoveResult result;
+
+    result.status = status;
+    result.color = turn;
+    result.start = start;
+    result.end = end;
+    result.piece = (status == MOVE_INVALID_INPUT ? NO_PIECE
+                                                 : get_square(start));
+    result.captured = NO_PIECE;
+    return result;
 }
 
 // Method: enter move
-bool ChessBoard::enter_move(Square start, Square end) {
-    if(!valid_move(start, end, turn, true))
-        return false;
+MoveResult ChessBoard::enter_move(Square start, Square end) {
+    MoveUndo undo;
+    MoveResult result;
+
+    result = new_result(valid_move(start, end, turn), start, end);
+    if(result.status != MOVE_OK)
+        return result;
 
-    print_move(start, end);
-    make_move(start, end);
+    make_move(start, end, undo);
+    result.captured = undo.captured;
 
     pass_turn();
-    print_game_state();
+    result.status = game_status().state;
 
-    if(check_game_end()) 
+    if(status.moves.size() == 0) {
         end_game();
+    }
+    else if(is_automatic_draw()) {
+        result.status = MOVE_DRAW;
+        end_game();
+    }
 
-    //print_board(); // DELETE!!
-
-    return true;
+    return result;
 }
 
 // Method: valid move. 
-// Validates move from Square "start" to Square "end".
-// Bool "verbose" tracks if we should output error log.
-bool ChessBoard::valid_move(Square start, Square end,
-                            Color color, bool verbose) {
-    if(!ok_start_square(start, color, verbose)) return false;
+// Validates move from Square "start" to Square "end". It returns MOVE_OK if
+// move is valid and reason why it isn't otherwise.
+MoveStatus ChessBoard::valid_move(Square start, Square end, Color color) {
+    MoveStatus start_status = ok_start_square(start, color);
+
+    if(start_status != MOVE_OK) return start_status;
 
 	// Any of the next conditions means that piece can't make that move.
-    if(!can_move(start, end, verbose)
-    	|| !ok_end_square(end, color, verbose)
-    	|| !ok_end_position(start, end, color, verbose)) {
-		
-		if(verbose) {
-			get_square(start)->print_name(cerr);
-			cerr << " cannot move to " << end << "!" << endl;
-		}
-		return false;
-	}
+    if(!can_move(start, end) || !ok_end_square(end, color))
+        return MOVE_ILLEGAL;
 
-    return true;
+    if(!ok_end_position(start, end, color))
+        return MOVE_LEAVES_CHECK;
+
+    return MOVE_OK;
 }
 
 // Method: ok_start_square
-bool ChessBoard::ok_start_square(Square square,
-                                 Color color, bool verbose) {
-    if(get_square(square) == NULL) {  // Start square can't be empty.
-        if(verbose)
-            cerr << "There is no piece at position " << square << "!" << endl;
-        return false;
-    }
+MoveStatus ChessBoard::ok_start_square(Square square, Color color) {
+    if(get_square(square) == NO_PIECE)  // Start square can't be empty.
+        return MOVE_NO_PIECE;
 
-    if(!validate_square_color(square, color)) {  // You have to move piece of
-        if(verbose) {                            // your color.
-            cerr << "It is not " << color_to_string(inverse_color(color))
-                << "'s turn to move!" << endl;
-        }
-        return false;
-    }
+    if(!validate_square_color(square, color))  // You have to move piece of
+        return MOVE_WRONG_TURN;                // your color.
 
-    return true;
+    return MOVE_OK;
 }
 
 // Method ok_end_square
-bool ChessBoard::ok_end_square(Square square,
-                               Color color, bool verbose) {
-    if(get_square(square) == NULL) return true; // End square can be empty.
+bool ChessBoard::ok_end_square(Square square, Color color) {
+    if(get_square(square) == NO_PIECE) return true; // End square can be empty.
 
     if(validate_square_color(square, color)) {
             return false;
@@ -360,14 +518,14 @@ bool ChessBoard::ok_end_square(Square square,
 // rules.
 // NOTE: doesn't check if end square is of the same color. That is what
 // function "ok_end_square" takes care of.
-bool ChessBoard::can_move(Square start, Square end, bool verbose) {
+bool ChessBoard::can_move(Square start, Square end) {
     // We make this just to ensure no unwanted erros are popped.
-    if(get_square(start) == NULL) return false;
+    if(get_square(start) == NO_PIECE) return false;
 
-    if(!ok_piece_move(start, end, verbose)) 
+    if(!ok_piece_move(start, end)) 
         return false;
     
-    if(!get_square(start)->get_jumps()) {  // If piece doesn't jump, check path.
+    if(!PIECE_JUMPS[get_square(start)]) {  // If piece doesn't jump, check path.
         if(!free_path(start, end))
             return false;
     }
@@ -377,20 +535,20 @@ bool ChessBoard::can_move(Square start, Square end, bool verbose) {
 // Method: ok piece move
 // Checks if move at Square "start", can move from Square "start" to
 // Square "end" if board is EMTPY!!!
-bool ChessBoard::ok_piece_move(Square start, Square end, bool verbose) {
+bool ChessBoard::ok_piece_move(Square start, Square end) {
     Color piece_color;
     int pawn_line, dx, dy; // dx and dy present piece's move.
     bool first, eats; // "first" means if we are in pawn line.
                       // "eats" means if we we will eat piece with this move.
 
-    piece_color = get_square(start)->get_color();
+    piece_color = position.color_at(square_index(start));
     pawn_line = get_pawn_line(piece_color);
     first = (pawn_line == start.y);
-    eats = (get_square(end) != NULL);
+    eats = !position.is_empty(square_index(end));
     dx = end.x - start.x;
     dy = end.y - start.y;
 
-    return ( get_square(start)->is_valid_move(dx, dy, eats, first) );
+    return is_valid_piece_move(get_square(start), dx, dy, eats, first);
 }
 
 // Method: free_path
@@ -406,7 +564,8 @@ bool ChessBoard::free_path(Square start, Square end) {
     y = start.y + dy;
 
     while(x!=end.x || y!=end.y) {
-        if(board[x][y] != NULL)  // If square on path is non-empty return false.
+        // If square on path is non-empty return false.
+        if(!position.is_empty(square_index(Square(x, y))))
             return false;
 
         x += dx;
@@ -415,10 +574,12 @@ bool ChessBoard::free_path(Square start, Square end) {
     return true;
 }
 
-// Method: check game end
-// Method that checks if player that is currently on play has no move.
-bool ChessBoard::check_game_end() {
-    return !has_valid_move(turn);
+// Method: is automatic draw
+// Fivefold repetition or 75 moves of both players without capture or pawn
+// move. Checkmate on the last of these moves still wins, so this is asked
+// only when player on turn has a move.
+bool ChessBoard::is_automatic_draw() const {
+    return halfmove_clock >= AUTO_DRAW_PLIES || is_repetition(4);
 }
 
 // Method: end game
@@ -430,8 +591,10 @@ void ChessBoard::end_game() {
 // This function first checks if pointer isn't NULL pointer to avoid errors.
 // Than it comparse color of piece at position "square" to color "color".
 bool ChessBoard::validate_square_color(Square square, Color color) {
-    if(get_square(square) == NULL) return false;
-    return (get_square(square)->get_color() == color);
+    int index = square_index(square);
+
+    if(position.is_empty(index)) return false;
+    return (position.color_at(index) == color);
 }
 
 // Method: get pawn line.
@@ -439,30 +602,171 @@ int ChessBoard::get_pawn_line(Color color) {
     return (color == WHITE ? 1 : 6);
 }
 
-// Method: make move.
-void ChessBoard::make_move(Square start, Square end) {
+// PUBLIC METHOD: make move.
+// =========================
+void ChessBoard::make_move(Square start, Square end, MoveUndo& undo) {
+    int start_index = square_index(start);
+    int end_index = square_index(end);
+    Color color = position.color_at(start_index);
+    PieceType type = position.type_at(start_index);
+
+    undo.captured = position.piece_at(end_index);
+    undo.game_finished = game_finished;
+    undo.halfmove_clock = halfmove_clock;
+    undo.key = key;
+    undo.eval = eval;
+    status_valid = false;
+
+    key_history[game_ply % KEY_HISTORY_SIZE] = key;
+    game_ply++;
+    if(undo.captured != NO_PIECE || type == PAWN) halfmove_clock = 0;
+    else halfmove_clock++;
+
+    if(undo.captured != NO_PIECE) {
+        key ^= ZOBRIST.pieces[piece_color(undo.captured)]
+                             [piece_type(undo.captured)][end_index];
+        eval_remove(eval, undo.captured, end_index);
+    }
+    key ^= ZOBRIST.pieces[color][type][start_index]
+           ^ ZOBRIST.pieces[color][type][end_index];
+    eval_remove(eval, make_piece(color, type), start_index);
+    eval_add(eval, make_piece(color, type), end_index);
+
     delete_square(end);
-    get_square(end) = get_square(start);
-    get_square(start) = NULL;
+    position.remove_piece(start_index);
+    position.put_piece(color, type, end_index);
+
+    if(type == KING)
+        king_squares[color] = end_index;
+}
+
+// PUBLIC METHOD: unmake move.
+// ===========================
+void ChessBoard::unmake_move(Square start, Square end, const MoveUndo& undo) {
+    int start_index = square_index(start);
+    int end_index = square_index(end);
+    Color color = position.color_at(end_index);
+    PieceType type = position.type_at(end_index);
+
+    position.remove_piece(end_index);
+    position.put_piece(color, type, start_index);
+    if(type == KING)
+        king_squares[color] = start_index;
+
+    if(undo.captured != NO_PIECE) {
+        position.put_piece(piece_color(undo.captured),
+                           piece_type(undo.captured), end_index);
+    }
+
+    game_finished = undo.game_finished;
+    halfmove_clock = undo.halfmove_clock;
+    game_ply--;
+    key = undo.key;
+    eval = undo.eval;
+    status_valid = false;
 }
 
-// Method: pass turn.
+// PUBLIC METHOD: pass turn.
+// =========================
 void ChessBoard::pass_turn() {
     turn = inverse_color(turn);
+    key ^= ZOBRIST.black_to_move;
+    status_valid = false;
+}
+
+// PUBLIC METHOD: is repetition.
+// =============================
+// Key before move "game_ply" - 1 belongs to the other player, so keys are
+// compared from 4 plies back (2 plies back is never the same position) in
+// steps of 2. Older keys than "halfmove_clock" can't repeat, and keys
+// before position was set are not known.
+bool ChessBoard::is_repetition(int count) const {
+    int limit = halfmove_clock;
+
+    if(limit > game_ply) limit = game_ply;
+    if(limit > KEY_HISTORY_SIZE) limit = KEY_HISTORY_SIZE;
+
+    for(int back=4; back<=limit; back+=2) {
+        if(key_history[(game_ply - back) % KEY_HISTORY_SIZE] == key
+           && --count == 0)
+            return true;
+    }
+    return false;
+}
+
+// PUBLIC METHOD: get halfmove clock.
+// ==================================
+int ChessBoard::get_halfmove_clock() const {
+    return halfmove_clock;
+}
+
+// PUBLIC METHOD: can claim draw.
+// ==============================
+bool ChessBoard::can_claim_draw() const {
+    return halfmove_clock >= FIFTY_MOVE_PLIES || is_repetition(2);
+}
+
+// PUBLIC METHOD: get turn.
+// ========================
+Color ChessBoard::get_turn() const {
+    return turn;
+}
+
+// PUBLIC METHOD: is game finished.
+bool ChessBoard::is_game_finished() const {
+    return game_finished;
+}
+
+// PUBLIC METHOD: get position.
+// ============================
+const Position& ChessBoard::get_position() const {
+    return position;
+}
+
+// PUBLIC METHOD: get eval.
+// ========================
+const EvalState& ChessBoard::get_eval() const {
+    return eval;
+}
+
+// PUBLIC METHOD: get key.
+// =======================
+Key ChessBoard::get_key() const {
+    return key;
+}
+
+// Method: compute key.
+// Computes Zobrist key from scratch. It is used only when board is set up,
+// after that key is updated by moves.
+Key ChessBoard::compute_key() const {
+    Key new_key = (turn == BLACK ? ZOBRIST.black_to_move : 0);
+
+    for(int color=0; color<2; color++) {
+        for(int type=0; type<6; type++) {
+            Bitboard pieces = position.get_pieces(static_cast<Color>(color),
+                                                  static_cast<PieceType>(type));
+            while(pieces)
+                new_key ^= ZOBRIST.pieces[color][type][pop_first_index(pieces)];
+        }
+    }
+    return new_key;
 }
 
 // Method: find king.
 // Function which returns Square on which king of Color "color" is.
-// If it doesn't find king on board (which should never happen) it returns
-// Square (0,0).
+// Squares of kings are kept up to date by make/unmake move, so this is just
+// a lookup.
 Square ChessBoard::find_king(Color color) {
-    for(int i=0; i<64; i++) {
-        ChessPiecePtr current_piece = get_square(Square(i));
+    return index_square(king_squares[color]);
+}
 
-        if(current_piece != NULL && current_piece->get_name() == "King"
-            && current_piece->get_color() == color) {
-                return Square(i);
-            }
+// Method: locate kings.
+// Finds both kings on board and stores their squares. It is used only when
+// board is set up. If king isn't on board (which should never happen) we
+// store Square (0,0).
+void ChessBoard::locate_kings() {
+    for(int color=0; color<2; color++) {
+        Bitboard king = position.get_pieces(static_cast<Color>(color), KING);
+        king_squares[color] = (king ? first_index(king) : 0);
     }
-    return Square(0);
 }
@@ -17,17 +17,56 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <string>
+#include <string_view>
 
-#include "ChessPiece.h"
+#include "Piece.h"
 #include "Square.h"
+#include "Position.h"
+#include "Move.h"
+#include "Zobrist.h"
+#include "ChessEvents.h"
+#include "Evaluation.h"
 
 // Function dif calculates if "x1" is smaller, equal or bigger to "x2".
 // If x1==x2 it returns 0, if x1<x2 it returns -1 and otherwise 1.
 int dif(int x1, int x2);
 
-// TYPEDEFs
-// ========
-typedef ChessPiece * ChessPiecePtr;
+// STRUCT: MoveUndo
+// ================
+// Small record filled by "make_move" and used by "unmake_move". It keeps
+// everything that move destroys and can't be recomputed: the captured piece
+// (NO_PIECE if move didn't capture), game flags, Zobrist key and evaluation
+// sums from before the move.
+struct MoveUndo {
+    Piece captured;
+    bool game_finished;
+    int halfmove_clock;
+    Key key;
+    EvalState eval;
+};
+
+// Draw rules, in plies without capture or pawn move (refer to "halfmove
+// clock" in ChessBoard): after FIFTY_MOVE_PLIES player can claim draw,
+// after AUTO_DRAW_PLIES game is drawn automatically.
+const int FIFTY_MOVE_PLIES = 100;
+const int AUTO_DRAW_PLIES = 150;
+
+// Number of position keys board remembers (refer to ChessBoard). Only
+// positions since last capture or pawn move can repeat, so after
+// AUTO_DRAW_PLIES game is over and more keys are never needed.
+const int KEY_HISTORY_SIZE = 256;
+
+// STRUCT: GameStatus
+// ==================
+// State of player on turn: "state" is MOVE_OK, MOVE_CHECK, MOVE_CHECKMATE or
+// MOVE_STALEMATE, "in_chess" tells if player is in chess and "moves" holds
+// all his legal moves (so moves.size() is their number).
+struct GameStatus {
+    MoveStatus state;
+    bool in_chess;
+    MoveList moves;
+};
 
 // CLASS: ChessBoard
 // =============================================================================
@@ -35,31 +74,66 @@ typedef ChessPiece * ChessPiecePtr;
 // With "game_finished" we keep track if the game is still running. Should
 // game be finished, we can no longer input new moves. To start new game,
 // resetBoard should be called. We keep track of who's turn it is with attribute
-// "turn", which is of type Color. Board is presented with "board" that contains
-// pointers to chess pieces. If pointer equals NULL, it means that given square
-// is empty.
+// "turn", which is of type Color. Board is presented with "position", which
+// keeps bitboards of all pieces (refer to Position.h). Chess pieces are
+// stored as piece codes, "get_square" returns code of piece standing on given
+// square or NO_PIECE if square is empty. Board owns no memory, so it is
+// copied as plain memory. Board has no static or global state of its own
+// (attack tables and Zobrist keys are only read), so threads can work in
+// parallel, each on its own board.
 //
 // User can interfere with class only with 3 functions:
 //    - resetBoard: sets new game
 // 	  - submitMove: make new move in game
 //	  - print_board: prints board state in ASCCI symbols.
+// Board itself doesn't print moves or errors. It reports them to event sink
+// (refer to ChessEvents.h), which is ConsoleEventSink unless user sets
+// other one. Board without sink is silent.
 // Example of use would be next 4 lines:
 //     ChessBoard cb;   <- creates new board and starts first game
 //     cb.submitMove("E2", "E4");   <- moves white's pawn
 //     cb.print_board();	<- print's board after first move.
 //	   cb.resetBoard();
 //
-// Imported header 1 is ChessPiece: class ChessPiece is used to represent 
-// pieces on board.
+// Imported header 1 is Piece: piece codes and tables with their symbols,
+// names and move rules are used to represent pieces on board.
 //
 // Imported header 2 is Square: class Square is used for fast access to the
 // board. NOTE THIS LOOP: for(int i=0; i<64; i++) Square(i).
 //                        ^ this loop iterates entire board (refer to Square.h). 
 //
-// On algorithms used: reader might note, that all algorithms used (to determine
-// chess, chessmate and stellmate) are brute force (O(n^6)). We realise that
-// this is not optimal approach, but because problem isn't scalable, solution
-// seems by far the best in terms of simplicity and readability. 
+// Imported header 3 is Position: class Position keeps bitboards of pieces.
+// Occupancy tests (free path, king search, ...) are single bit tests.
+//
+// Imported header 4 is Move: moves produced by move generator (refer to
+// MoveGen.h) are stored in MoveList, which lives on stack.
+//
+// Check detection uses precomputed attack tables (refer to Attacks.h), which
+// are filled when first board is created.
+//
+// Imported header 5 is Zobrist: board keeps Zobrist "key" of current position
+// and turn. It is updated by every move, so two positions can be compared
+// (or used as key in hash table) with one comparison.
+//
+// Imported header 6 is Evaluation: in the same way board keeps "eval", sums
+// of piece values and piece-square tables, so search never has to look at
+// all pieces to evaluate position.
+//
+// For draw rules board keeps "halfmove_clock" (plies since last capture or
+// pawn move) and keys of positions before every move in "key_history". It
+// is ring buffer: key before move number "game_ply" is stored at index
+// game_ply % KEY_HISTORY_SIZE. Capture or pawn move can't be taken back,
+// so repetition is looked for only in last "halfmove_clock" keys, and only
+// in every other one (same player on turn). Boards are never compared.
+//
+// On algorithms used: to determine chess, checkmate and stalemate we use move
+// generator, which produces only moves that pieces can actually make. Each
+// of these moves is then made on board, tested for chess and taken back.
+// Result (GameStatus) is computed once after every submitted move and kept
+// in "status" until board changes, so all later questions about it (is it
+// checkmate, which moves are legal) are answered without any work.
+// Validation of user's input still goes through "valid_move", which checks
+// rules for one given move.
 //
 // On comments: private functions are not commented in header file. Reader
 // should refer to .cpp file.
@@ -70,22 +144,38 @@ private:
     // ================
     bool game_finished;  // Bool that keeps track, when game is finished.
     Color turn;   // Keep track who's turn it is.
+    ChessEventSink* sink;  // Receives game events. NULL means silent board.
 
     // MAIN CONTAINER
     // ==============
-    ChessPiecePtr board[8][8];
+    Position position;
+    Key key;  // Zobrist key of "position" and "turn".
+    EvalState eval;  // Evaluation sums of "position" (refer to Evaluation.h).
+    int king_squares[2];  // Index of square with king, for each color.
+
+    // GAME HISTORY
+    // ============
+    Key key_history[KEY_HISTORY_SIZE];  // Keys before moves (ring buffer).
+    int game_ply;  // Number of moves made since position was set.
+    int start_ply;  // Ply of game at which position was set (from FEN).
+    int halfmove_clock;  // Plies since last capture or pawn move.
+
+    // CACHED STATE
+    // ============
+    GameStatus status;  // State of player on turn, if "status_valid".
+    bool status_valid;  // Cleared by every change of board.
 
     // GET FUNCTIONS
     // =================
-    ChessPiecePtr& get_square(Square square);   // Very important functions used
-												// for access.
+    Piece get_square(Square square) const;  // Very important functions used
+                                            // for access.
 
     // SET BOARD FUNCTIONS
     // ===================
     void reset_board();
+    void clear_history(int clock, int ply);
     void clear_board();
     void delete_square(Square square);
-    void set_board_null();
     void set_starting_set(Color color);
 
     // PRINT METHODS
@@ -94,44 +184,47 @@ private:
     void print_last_line() const;
     void print_square(int i, int j) const;
     void print_equals_line(int d) const;
-    void print_move(Square start, Square end);
-    void print_game_state();
 
     // GAME STATE METHODS
     // ==================
-    bool has_valid_move(Color color);
-    bool is_in_chess(Color color);
-    bool ok_end_position(Square start, Square end, Color color, bool verbose);
-    bool check_game_end();
+    void compute_status();
+    bool ok_end_position(Square start, Square end, Color color);
+    bool is_automatic_draw() const;
     void end_game();
 
     // MOVE VALIDATION METHODS
     // =======================
-    bool enter_move(Square start, Square end);
-    bool valid_move(Square start, Square end, Color color, bool verbose);
-    bool ok_start_square(Square square, Color color, bool verbose);
-    bool ok_end_square(Square square, Color color, bool verbose);
-    bool can_move(Square start, Square end, bool verbose);
-    bool ok_piece_move(Square start, Square end, bool verbose);
+    MoveResult enter_move(Square start, Square end);
+    MoveResult new_result(MoveStatus status, Square start, Square end);
+    MoveStatus valid_move(Square start, Square end, Color color);
+    MoveStatus ok_start_square(Square square, Color color);
+    bool ok_end_square(Square square, Color color);
+    bool can_move(Square start, Square end);
+    bool ok_piece_move(Square start, Square end);
     bool free_path(Square start, Square end);
 
-    // MODIFICATION METHODS
-    // ====================
-    void make_move(Square start, Square end);
-    void pass_turn();
-
     // HELPER FUNCTIONS
     // ================
+    Key compute_key() const;
     bool validate_square_color(Square square, Color color);
     int get_pawn_line(Color color);
     Square find_king(Color color);
+    void locate_kings();
 
 public:
     // CONSTRUCTORS / DESTRUCTORS
     // ==========================
+    // Basic constructor makes board that prints to console. Board made with
+    // second constructor reports to "sink" (refer to ChessEvents.h); if
+    // "sink" is NULL, board doesn't print anything.
     ChessBoard();
-    ChessBoard(ChessBoard& old);
-    virtual ~ChessBoard();
+    ChessBoard(ChessEventSink* sink);
+
+    // PUBLIC METHOD: set event sink
+    // =============================
+    // Changes sink that receives game events. NULL makes board silent.
+    // Board doesn't own the sink, it has to outlive the board.
+    void set_event_sink(ChessEventSink* sink);
 
     // PUBLIC METHOD: new game
     // =======================
@@ -139,6 +232,20 @@ public:
     // starting positions. Sets "turn" to WHITE and "game_finished" to false.
     void resetBoard();
 
+    // PUBLIC METHODS: from / to fen
+    // =============================
+    // "from_fen" sets position and player on turn from FEN string, for
+    // example "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b - - 0 1".
+    // Game is finished right away if player on turn has no legal move.
+    // Castling and en passant fields can be present, but are ignored. Move
+    // counters are optional; halfmove clock is used by draw rules.
+    // Function returns false (and doesn't change board) if FEN is wrong, if
+    // there isn't exactly one king of each color or if player who is not on
+    // turn is in chess. Nothing is reported to event sink.
+    // "to_fen" writes current position as FEN string.
+    bool from_fen(string_view fen);
+    string to_fen() const;
+
     // PUBLIC METHOD: print board
     // ==========================
     // This method prints chess board with ASCII signs.
@@ -149,8 +256,83 @@ public:
     // This method take starting and ending square. Both squares should be in
     // format [A-H][1-8]. If move is not valid in any way (invalid input,
     // against the rules, etc) function returns false. If function succeeds
-    // it returns true.
-    bool submitMove(string start, string end);
+    // it returns true. What happened is reported to event sink.
+    // Squares are taken as string_view, so submitting move doesn't
+    // allocate or copy anything.
+    bool submitMove(string_view start, string_view end);
+
+    // Silent version of submitMove. It takes squares that are already
+    // converted, never reports anything and returns full result: status
+    // (why move was rejected or state of opponent after the move), moved
+    // and captured piece.
+    MoveResult submitMove(Square start, Square end);
+
+    // PUBLIC METHOD: make / unmake move
+    // =================================
+    // "make_move" moves piece from Square "start" to Square "end" in place and
+    // writes everything needed to take the move back in "undo". "unmake_move"
+    // takes the same squares and record and restores board exactly as it was.
+    // Moves must be unmade in reverse order of making them.
+    // NOTE: these methods don't validate the move and don't pass the turn.
+    void make_move(Square start, Square end, MoveUndo& undo);
+    void unmake_move(Square start, Square end, const MoveUndo& undo);
+
+    // PUBLIC METHOD: pass turn
+    // ========================
+    // Gives move to the other player. Used together with make/unmake move.
+    void pass_turn();
+
+    // PUBLIC METHOD: legal moves
+    // ==========================
+    // This method fills MoveList "moves" with all legal moves of player
+    // whose turn it is. If game is finished, list stays empty.
+    void legal_moves(MoveList& moves);
+
+    // PUBLIC METHOD: is in chess
+    // ==========================
+    // Tells if king of Color "color" is attacked. It is cheap (few table
+    // lookups), so search asks it in every position.
+    bool is_in_chess(Color color);
+
+    // PUBLIC METHOD: game status
+    // ==========================
+    // Returns state of player on turn: chess, checkmate, stalemate and legal
+    // moves (refer to GameStatus). It is computed at most once per position;
+    // after submitMove it is already computed. Reference is valid until
+    // board changes.
+    const GameStatus& game_status();
+
+    // PUBLIC METHODS: draw rules
+    // ==========================
+    // "is_repetition" tells if current position with the same player on turn
+    // occurred at least "count" times before. It compares only keys since
+    // last capture or pawn move, so search can call it in every node.
+    // "get_halfmove_clock" returns number of plies since last capture or
+    // pawn move. "can_claim_draw" tells if player on turn can claim draw by
+    // threefold repetition or fifty-move rule. Fivefold repetition and
+    // 75-move rule end game automatically (refer to MOVE_DRAW).
+    bool is_repetition(int count) const;
+    int get_halfmove_clock() const;
+    bool can_claim_draw() const;
+
+    // PUBLIC METHODS: get state
+    // =========================
+    // Read-only access to player on turn, to end of game and to placement
+    // of pieces.
+    Color get_turn() const;
+    bool is_game_finished() const;
+    const Position& get_position() const;
+
+    // PUBLIC METHOD: get key
+    // ======================
+    // Returns Zobrist key of current position and player on turn.
+    Key get_key() const;
+
+    // PUBLIC METHOD: get eval
+    // =======================
+    // Returns evaluation sums of current position, which are updated by
+    // every move. Score is "evaluate(get_eval(), color)".
+    const EvalState& get_eval() const;
 };
 
 
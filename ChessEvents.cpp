@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: ChessEvents.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to ChessEvents.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ChessEvents.h"
+
+///////////////////////////////// ChessEventSink ///////////////////////////////
+
+// Destructor.
+ChessEventSink::~ChessEventSink() {
+    // Deliberately empty.
+}
+
+// New game.
+void ChessEventSink::new_game() {
+    // Deliberately empty.
+}
+
+// Move made.
+void ChessEventSink::move_made(const MoveResult& result) {
+    // Deliberately empty.
+}
+
+// Move rejected.
+void ChessEventSink::move_rejected(const MoveResult& result) {
+    // Deliberately empty.
+}
+
+///////////////////////////////// ConsoleEventSink /////////////////////////////
+// NOTE: "cerr" is tied to "cout", so "cout" is flushed before every error and
+// output stays in order without flushing after each line.
+
+// Destructor.
+ConsoleEventSink::~ConsoleEventSink() {
+    // Deliberately empty.
+}
+
+// New game.
+void ConsoleEventSink::new_game() {
+    cout << "A new chess game is started!\n";
+}
+
+// Move made.
+// Prints move, e. g. "White's Pawn moves from E2 to E4", and state of the
+// player that is on turn now, e. g. "Black is in check".
+void ConsoleEventSink::move_made(const MoveResult& result) {
+    print_piece_name(cout, result.piece);
+    cout << " moves from " << result.start << " to " << result.end;
+    if(result.captured != NO_PIECE) {
+        cout << " taking ";
+        print_piece_name(cout, result.captured);
+    }
+    cout << "\n";
+
+    if(result.status == MOVE_DRAW) {
+        cout << "Game is drawn\n";
+    }
+    else if(result.status != MOVE_OK) {
+        cout << color_to_string(inverse_color(result.color)) << " is in ";
+        if(result.status == MOVE_CHECKMATE) cout << "checkmate";
+        else if(result.status == MOVE_STALEMATE) cout << "stellmate";
+        else cout << "check";
+        cout << "\n";
+    }
+}
+
+// Move rejected.
+// Prints reason why move was rejected. Nothing is printed for moves
+// submitted after the game is over.
+void ConsoleEventSink::move_rejected(const MoveResult& result) {
+    switch(result.status) {
+        case MOVE_INVALID_INPUT:
+            cerr << "Invalid input!\n";
+            break;
+        case MOVE_NO_PIECE:
+            cerr << "There is no piece at position " << result.start << "!\n";
+            break;
+        case MOVE_WRONG_TURN:
+            cerr << "It is not " << color_to_string(inverse_color(result.color))
+                 << "'s turn to move!\n";
+            break;
+        case MOVE_LEAVES_CHECK:
+            cerr << "This move leaves you in check!\n";
+            // Continues to MOVE_ILLEGAL.
+        case MOVE_ILLEGAL:
+            print_piece_name(cerr, result.piece);
+            cerr << " cannot move to " << result.end << "!\n";
+            break;
+        default:
+            break;
+    }
+}
+
+// Function console event sink.
+ConsoleEventSink* console_event_sink() {
+    static ConsoleEventSink sink;
+    return &sink;
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: ChessEvents.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file with result of submitted move (MoveStatus and
+//              MoveResult) and with interface ChessEventSink, through which
+//              ChessBoard reports what happens in game. ChessBoard itself
+//              never prints anything; all human readable output is done by
+//              ConsoleEventSink. Board without sink is completely silent.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHESSEVENTS_H_
+#define CHESSEVENTS_H_
+
+#include <iostream>
+
+#include "Piece.h"
+#include "Square.h"
+
+using namespace std;
+
+
+// Enumerator: MoveStatus tells what happened with submitted move.
+// First five values mean that move was made; they also tell state of the
+// player that is on turn after the move. All other values mean that move
+// was rejected and tell why.
+enum MoveStatus {
+    MOVE_OK,               // Move was made.
+    MOVE_CHECK,            // Move was made, opponent is in check.
+    MOVE_CHECKMATE,        // Move was made, opponent is in checkmate.
+    MOVE_STALEMATE,        // Move was made, opponent has no move.
+    MOVE_DRAW,             // Move was made, game is drawn by rule (fivefold
+                           // repetition or 75 moves without capture or
+                           // pawn move).
+    MOVE_GAME_FINISHED,    // Game is over, board has to be reset.
+    MOVE_INVALID_INPUT,    // Square is not in format [A-H][1-8].
+    MOVE_NO_PIECE,         // There is no piece on starting square.
+    MOVE_WRONG_TURN,       // Piece belongs to player who is not on turn.
+    MOVE_ILLEGAL,          // Piece can't move to ending square.
+    MOVE_LEAVES_CHECK      // Move would leave own king in check.
+};
+
+// Function that tells if MoveStatus "status" means that move was made.
+inline bool move_accepted(MoveStatus status) {
+    return status <= MOVE_DRAW;
+}
+
+// STRUCT: MoveResult
+// ==================
+// Everything we know about submitted move. "color" is player who submitted
+// the move, "piece" is piece on starting square and "captured" is piece
+// that was taken (NO_PIECE if move didn't take anything or wasn't made).
+struct MoveResult {
+    MoveStatus status;
+    Color color;
+    Square start;
+    Square end;
+    Piece piece;
+    Piece captured;
+};
+
+// CLASS: ChessEventSink
+// =====================
+// Interface for receiving events from ChessBoard. All methods are empty by
+// default, so derived class overrides only events it cares about.
+//    - new_game: board was reset.
+//    - move_made: move was made ("result.status" is accepted status).
+//    - move_rejected: move was rejected ("result.status" tells why).
+class ChessEventSink {
+public:
+    virtual ~ChessEventSink();
+
+    virtual void new_game();
+    virtual void move_made(const MoveResult& result);
+    virtual void move_rejected(const MoveResult& result);
+};
+
+// CLASS: ConsoleEventSink
+// =======================
+// Sink that prints events in human readable form: moves and game state go to
+// "cout", errors to "cerr". This is what ChessBoard prints by default.
+class ConsoleEventSink: public ChessEventSink {
+public:
+    virtual ~ConsoleEventSink();
+
+    void new_game();
+    void move_made(const MoveResult& result);
+    void move_rejected(const MoveResult& result);
+};
+
+// Function that returns shared ConsoleEventSink. It has no state, so all
+// boards can use the same one.
+ConsoleEventSink* console_event_sink();
+
+
+#endif // CHESSEVENTS_H_
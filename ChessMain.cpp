@@ -3,8 +3,76 @@
 using namespace std;
 
 #include "ChessBoard.hpp"
+#include "PgnReader.h"
+#include "MappedFile.h"
+#include "GameArchive.h"
+
+// Function replay archive.
+// Plays all games of binary archive and prints one line for every game.
+// Returns number of games with illegal move.
+static int replay_archive(const char* path, const ArchiveReader& archive,
+                          ChessBoard& board) {
+    int failed = 0;
+
+    for(unsigned long long i=0; i<archive.size(); i++) {
+        ArchiveGame game;
+        int played = archive.replay(i, board);
+        bool ok = archive.get_game(i, game) && played == game.plies;
+
+        cout << path << " game " << i+1 << ": " << played << " moves";
+        if(ok) cout << ", " << result_to_string(game.result);
+        else {
+            cout << ", illegal move";
+            failed++;
+        }
+        cout << "\n";
+    }
+    return failed;
+}
+
+// Function replay pgn.
+// Plays all games in PGN files (or binary archives) given on command line
+// and prints one line for every game. Returns 1 if any file couldn't be
+// opened or any game had illegal move.
+static int replay_pgn(int argc, char* argv[]) {
+    ChessBoard board(NULL);
+    PgnGame game;
+    int failed = 0;
+
+    for(int i=1; i<argc; i++) {
+        ArchiveReader archive;
+        MappedFile file;
+
+        if(archive.open(argv[i])) {
+            failed += replay_archive(argv[i], archive, board);
+            continue;
+        }
+
+        if(!file.open(argv[i])) {
+            cerr << "Can't open " << argv[i] << "!" << endl;
+            failed++;
+            continue;
+        }
+
+        PgnReader reader(file.get_view());
+        while(reader.read_game(board, game)) {
+            cout << argv[i] << " game " << game.number << ": "
+                 << game.plies << " moves";
+            if(game.result[0] != '\0') cout << ", " << game.result;
+            if(!game.ok) {
+                cout << ", " << game.error;
+                if(game.error_move[0] != '\0') cout << " " << game.error_move;
+                failed++;
+            }
+            cout << "\n";
+        }
+    }
+    return failed > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
 
-int main() {
+    if(argc > 1) return replay_pgn(argc, argv);
 
     cout << "===========================" << endl;
     cout << "Testing the Chess Engine" << endl;
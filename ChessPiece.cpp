@@ -8,29 +8,21 @@
 #include "ChessPiece.h"
 
 
-// Function that inverts color.
-Color inverse_color(Color color) {
-    return (color==WHITE ? BLACK : WHITE);
-}
-
-// Color_to_string.
-string color_to_string(Color color) {
-    return (color == WHITE ? "White" : "Black");
-}
-
 ///////////////////////////////// ChessPiece ///////////////////////////////////
 
 // Constructor.
 ChessPiece::ChessPiece() {
-    // Deliberately empty.
+    piece = NO_PIECE;
+}
+
+// Constructor from piece code.
+ChessPiece::ChessPiece(Piece new_piece) {
+    piece = new_piece;
 }
 
 // Copy constructor.
 ChessPiece::ChessPiece(const ChessPiece& new_piece) {
-    symbol = new_piece.symbol;
-    name = new_piece.name;
-    color = new_piece.color;
-    jumps = new_piece.jumps;
+    piece = new_piece.piece;
 }
 
 // Destructor.
@@ -45,80 +37,54 @@ ChessPiece * ChessPiece::clone() const {
 
 // Assignment.
 ChessPiece& ChessPiece::operator=(const ChessPiece& new_piece) {
-    symbol = new_piece.symbol;
-    name = new_piece.name;
-    color = new_piece.color;
-    jumps = new_piece.jumps;
+    piece = new_piece.piece;
 
 	return (*this);
 }
 
-// Set symbol.
-void ChessPiece::set_symbol(char new_symbol) {
-    symbol = new_symbol;
-}
-
-// Set name.
-void ChessPiece::set_name(string new_name) {
-    name = new_name;
-}
-
-// Set color.
-void ChessPiece::set_color(Color new_color) {
-    color = new_color;
-}
-
-// Set jumps.
-void ChessPiece::set_jumps(bool new_jumps) {
-    jumps = new_jumps;
+// Get piece code.
+Piece ChessPiece::get_piece() const {
+    return piece;
 }
 
 // Get jumps.
-bool ChessPiece::get_jumps() {
-    return jumps;
+bool ChessPiece::get_jumps() const {
+    return PIECE_JUMPS[piece];
 }
 
 // Get color.
-Color ChessPiece::get_color() {
-    return color;
+Color ChessPiece::get_color() const {
+    return piece_color(piece);
 }
 
 // Get name.
-string ChessPiece::get_name() {
-    return name;
+string ChessPiece::get_name() const {
+    return PIECE_NAMES[piece];
 }
 
 // Print function.
-void ChessPiece::print_ascii(ostream& outs) {
-    char side_char;
-
-    side_char = (color == WHITE ? ' ' : '=');
-    outs << side_char;
-    outs << symbol;
-    outs << side_char;
+void ChessPiece::print_ascii(ostream& outs) const {
+    print_piece_ascii(outs, piece);
 }
 
 // Print name.
-void ChessPiece::print_name(ostream& outs) {
-    outs << color_to_string(color);
-    outs << "'s ";
-    outs << name;
+void ChessPiece::print_name(ostream& outs) const {
+    print_piece_name(outs, piece);
 }
 
-// Dummy definition of virtual function.
+// Method that tells if move is valid.
+// Rules of all pieces are in table MOVE_RULES (refer to Piece.h).
 bool ChessPiece::is_valid_move(int dx, int dy,
-                               bool eats, bool first) {
-    return false;
+                               bool eats, bool first) const {
+    if(piece == NO_PIECE) return false;
+    if(abs(dx) > 7 || abs(dy) > 7) return false;
+    return is_valid_piece_move(piece, dx, dy, eats, first);
 }
 
 ///////////////////////////////// King /////////////////////////////////////////
 
 // Constructor.
-King::King(Color _color) {
-    set_symbol('K');
-    set_name("King");
-    set_color(_color);
-    set_jumps(false);
+King::King(Color _color) : ChessPiece(make_piece(_color, KING)) {
 }
 
 // Destructor.
@@ -131,23 +97,10 @@ King * King::clone() const {
     return (new King(*this));
 }
 
-// Method that tells if move is valid.
-// Move is valid when king moves for 0-1 in each directon, but not 0 in both
-// directions.
-bool King::is_valid_move(int dx, int dy, bool eats, bool first) {
-    if(dx==0 && dy==0) return false;
-    if(abs(dx) > 1 || abs(dy) > 1) return false;
-    return true;
-}
-
 ///////////////////////////////// Queen ////////////////////////////////////////
 
 // Constructor.
-Queen::Queen(Color _color) {
-    set_symbol('Q');
-    set_name("Queen");
-    set_color(_color);
-    set_jumps(false);
+Queen::Queen(Color _color) : ChessPiece(make_piece(_color, QUEEN)) {
 }
 
 // Destructor
@@ -160,24 +113,10 @@ Queen * Queen::clone() const {
     return (new Queen(*this));
 }
 
-// Method that tells if move is valid.
-// Move is valid when queen moves in diagonal or side-way direction.
-bool Queen::is_valid_move(int dx, int dy, bool eats, bool first) {
-    if(dx==0 && dy==0) return false; // not moving
-    if(abs(dx) == abs(dy)) return true; // diagonal moves
-    if(dx == 0 || dy == 0) return true; // side move
-
-    return false; // all other moves are invalid
-}
-
 ///////////////////////////////// Bishop ///////////////////////////////////////
 
 // Constructor.
-Bishop::Bishop(Color _color) {
-    set_symbol('B');
-    set_name("Bishop");
-    set_color(_color);
-    set_jumps(false);
+Bishop::Bishop(Color _color) : ChessPiece(make_piece(_color, BISHOP)) {
 }
 
 // Destructor
@@ -190,23 +129,10 @@ Bishop * Bishop::clone() const {
     return (new Bishop(*this));
 }
 
-// Method that tells if move is valid.
-// Move is valid when bishop moves in diagonal direction.
-bool Bishop::is_valid_move(int dx, int dy, bool eats, bool first) {
-    if(dx==0 && dy==0) return false; // not moving
-    if(abs(dx) == abs(dy)) return true; // diagonal moves
-
-    return false; // all other moves are invalid
-}
-
 ///////////////////////////////// Knight ///////////////////////////////////////
 
 // Constructor.
-Knight::Knight(Color _color) {
-    set_symbol('N');
-    set_name("Knight");
-    set_color(_color);
-    set_jumps(true);
+Knight::Knight(Color _color) : ChessPiece(make_piece(_color, KNIGHT)) {
 }
 
 // Destructor
@@ -219,25 +145,10 @@ Knight * Knight::clone() const {
     return (new Knight(*this));
 }
 
-
-// Method that tells if move is valid.
-// Move is valid when one coordinate change has absolute value of 2 and
-// another one absolute value of 1.
-bool Knight::is_valid_move(int dx, int dy, bool eats, bool first) {
-    if(abs(dx) == 1 && abs(dy) == 2) return true; // jump direction 1
-    if(abs(dy) == 1 && abs(dx) == 2) return true; // mirror jump direction
-
-    return false; // all other moves are invalid
-}
-
 ///////////////////////////////// Rook /////////////////////////////////////////
 
 // Constructor.
-Rook::Rook(Color _color) {
-    set_symbol('R');
-    set_name("Rook");
-    set_color(_color);
-    set_jumps(false);
+Rook::Rook(Color _color) : ChessPiece(make_piece(_color, ROOK)) {
 }
 
 // Destructor
@@ -250,23 +161,10 @@ Rook * Rook::clone() const {
     return (new Rook(*this));
 }
 
-// Method that tells if move is valid.
-// Move is valid when rook moves side-way.
-bool Rook::is_valid_move(int dx, int dy, bool eats, bool first) {
-    if(dx==0 && dy==0) return false; // not moving
-    if(dx == 0 || dy == 0) return true; // side move
-
-    return false; // all other moves are invalid
-}
-
 ///////////////////////////////// Pawn /////////////////////////////////////////
 
 // Constructor.
-Pawn::Pawn(Color _color) {
-    set_symbol('P');
-    set_name("Pawn");
-    set_color(_color);
-    set_jumps(false);
+Pawn::Pawn(Color _color) : ChessPiece(make_piece(_color, PAWN)) {
 }
 
 // Destructor
@@ -278,21 +176,3 @@ Pawn::~Pawn() {
 Pawn * Pawn::clone() const{
     return (new Pawn(*this));
 }
-
-// Method that tells if move is valid.
-// Pawn is most complicated. Several options have to be checked.
-bool Pawn::is_valid_move(int dx, int dy, bool eats, bool first) {
-    // First block checks vertical movement.
-    if(get_color() == BLACK) { // we mirror vertical movement for black.
-        dy *= -1;
-    }
-    if(dy == 2 && !first) return false;
-    if(dy != 2 && dy != 1) return false;
-
-    // Second block check horizontal movement.
-    if(eats && abs(dx)!=1) return false; // Always eat side-ways.
-    if(!eats && dx!=0) return false;
-
-    // We passed all test.
-    return true;
-}
@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Evaluation.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Evaluation.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Evaluation.h"
+
+// Function compute eval.
+EvalState compute_eval(const Position& position) {
+    EvalState eval = {0, 0, 0};
+    Bitboard occupied = position.get_occupied();
+
+    while(occupied) {
+        int index = pop_first_index(occupied);
+        eval_add(eval, position.piece_at(index), index);
+    }
+    return eval;
+}
+
+// Function evaluate.
+// Phase can be above MAX_PHASE in position set from FEN with more pieces
+// than at the start (there is no promotion), so it is limited first.
+int evaluate(const EvalState& eval, Color color) {
+    int phase = eval.phase < MAX_PHASE ? eval.phase : MAX_PHASE;
+    int score = (eval.mg * phase + eval.eg * (MAX_PHASE - phase)) / MAX_PHASE;
+
+    return color == WHITE ? score : -score;
+}
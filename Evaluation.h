@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Evaluation.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for static evaluation of position. Score is in
+//              centipawns (pawn is worth 100) and is positive if position is
+//              good for player of given color.
+//
+//              Evaluation is material plus piece-square tables (bonus for
+//              piece standing on given square). Every piece has two values,
+//              one for middlegame and one for endgame; final score is mix of
+//              both, weighted by how much material is still on the board
+//              ("tapered" evaluation).
+//
+//              Evaluation is sum of values of single pieces, so it doesn't
+//              have to be computed from scratch: ChessBoard keeps EvalState
+//              and adds or subtracts values of pieces as they move (refer to
+//              ChessBoard::make_move). Only "evaluate" is left for leaves of
+//              search, and it is few multiplications.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EVALUATION_H_
+#define EVALUATION_H_
+
+#include "Piece.h"
+#include "Position.h"
+
+
+// Value of every piece type in middlegame and endgame. King is never taken,
+// so its value is 0. PIECE_VALUES is used where one value is enough (for
+// example ordering of captures).
+const int PIECE_VALUES[6] = {100, 320, 330, 500, 900, 0};
+const int PIECE_VALUES_MG[6] = {100, 320, 330, 500, 900, 0};
+const int PIECE_VALUES_EG[6] = {100, 300, 320, 520, 920, 0};
+
+// Game phase. Every piece except pawn and king adds to phase; phase of
+// starting position is MAX_PHASE (full middlegame), phase 0 is endgame.
+const int PHASE_WEIGHTS[6] = {0, 1, 1, 2, 4, 0};
+const int MAX_PHASE = 24;
+
+// PIECE-SQUARE TABLES
+// ===================
+// Tables are written as board is seen by white: first row is row 8, last
+// row is row 1. Black uses the same tables, mirrored.
+// NOTE: pawns don't promote in this engine, so there is no bonus for pawn
+//       close to last row. Pawn that reaches last row can't move or take
+//       anymore, so it gets penalty instead.
+inline constexpr int PIECE_SQUARE_TABLES[6][64] = {
+    {  // PAWN
+        -30,-30,-30,-30,-30,-30,-30,-30,
+         10, 10, 10, 10, 10, 10, 10, 10,
+         10, 10, 20, 30, 30, 20, 10, 10,
+          5,  5, 10, 25, 25, 10,  5,  5,
+          0,  0,  0, 20, 20,  0,  0,  0,
+          5, -5,-10,  0,  0,-10, -5,  5,
+          5, 10, 10,-20,-20, 10, 10,  5,
+          0,  0,  0,  0,  0,  0,  0,  0
+    },
+    {  // KNIGHT
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    },
+    {  // BISHOP
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    },
+    {  // ROOK
+          0,  0,  0,  0,  0,  0,  0,  0,
+          5, 10, 10, 10, 10, 10, 10,  5,
+         -5,  0,  0,  0,  0,  0,  0, -5,
+         -5,  0,  0,  0,  0,  0,  0, -5,
+         -5,  0,  0,  0,  0,  0,  0, -5,
+         -5,  0,  0,  0,  0,  0,  0, -5,
+         -5,  0,  0,  0,  0,  0,  0, -5,
+          0,  0,  0,  5,  5,  0,  0,  0
+    },
+    {  // QUEEN
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+          0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    },
+    {  // KING
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+         20, 20,  0,  0,  0,  0, 20, 20,
+         20, 30, 10,  0,  0, 10, 30, 20
+    }
+};
+
+// In endgame pawns and king use their own tables: pawns should advance and
+// king should come to the center. Other pieces use the same tables.
+inline constexpr int PAWN_ENDGAME_TABLE[64] = {
+    -30,-30,-30,-30,-30,-30,-30,-30,
+     20, 20, 20, 20, 20, 20, 20, 20,
+     15, 15, 15, 15, 15, 15, 15, 15,
+     10, 10, 10, 10, 10, 10, 10, 10,
+      5,  5,  5,  5,  5,  5,  5,  5,
+      0,  0,  0,  0,  0,  0,  0,  0,
+      0,  0,  0,  0,  0,  0,  0,  0,
+      0,  0,  0,  0,  0,  0,  0,  0
+};
+
+inline constexpr int KING_ENDGAME_TABLE[64] = {
+    -50,-40,-30,-20,-20,-30,-40,-50,
+    -30,-20,-10,  0,  0,-10,-20,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-30,  0,  0,  0,  0,-30,-30,
+    -50,-30,-30,-30,-30,-30,-30,-50
+};
+
+// STRUCT: EvalState
+// =================
+// Sums over all pieces on the board: middlegame and endgame score (from the
+// point of view of white) and phase.
+struct EvalState {
+    int mg;
+    int eg;
+    int phase;
+};
+
+// STRUCT: PieceSquareValues
+// =========================
+// Value (material and table) of every piece code on every square, from the
+// point of view of white, so values of black pieces are negative.
+struct PieceSquareValues {
+    int mg[PIECE_CODES][64];
+    int eg[PIECE_CODES][64];
+};
+
+// Function make piece square values.
+// Square "index" of white piece is looked up in row 7 - index/8 of tables,
+// which is index ^ 56. For black piece tables are mirrored, so it is just
+// "index".
+constexpr PieceSquareValues make_piece_square_values() {
+    PieceSquareValues values = {};
+
+    for(int piece=0; piece<PIECE_CODES; piece++) {
+        Piece code = static_cast<Piece>(piece);
+        int type = piece_type(code);
+
+        if(type >= NO_PIECE_TYPE) continue;  // codes 6, 7, 14, 15
+        for(int index=0; index<64; index++) {
+            bool white = (piece_color(code) == WHITE);
+            int square = white ? (index ^ 56) : index;
+            int sign = white ? 1 : -1;
+            int mg = PIECE_VALUES_MG[type] + PIECE_SQUARE_TABLES[type][square];
+            int eg = PIECE_VALUES_EG[type];
+
+            if(type == PAWN) eg += PAWN_ENDGAME_TABLE[square];
+            else if(type == KING) eg += KING_ENDGAME_TABLE[square];
+            else eg += PIECE_SQUARE_TABLES[type][square];
+
+            values.mg[piece][index] = sign * mg;
+            values.eg[piece][index] = sign * eg;
+        }
+    }
+    return values;
+}
+
+inline constexpr PieceSquareValues PIECE_SQUARE_VALUES =
+    make_piece_square_values();
+
+// INLINE FUNCTIONS
+// ================
+// Called for every piece that moves, so they are inline.
+
+// Functions that add and remove value of Piece "piece" on square "index".
+inline void eval_add(EvalState& eval, Piece piece, int index) {
+    eval.mg += PIECE_SQUARE_VALUES.mg[piece][index];
+    eval.eg += PIECE_SQUARE_VALUES.eg[piece][index];
+    eval.phase += PHASE_WEIGHTS[piece_type(piece)];
+}
+
+inline void eval_remove(EvalState& eval, Piece piece, int index) {
+    eval.mg -= PIECE_SQUARE_VALUES.mg[piece][index];
+    eval.eg -= PIECE_SQUARE_VALUES.eg[piece][index];
+    eval.phase -= PHASE_WEIGHTS[piece_type(piece)];
+}
+
+// Function compute eval.
+// Computes EvalState of "position" from scratch. It is used when position
+// is set up (new game, FEN); after that EvalState is updated by moves.
+EvalState compute_eval(const Position& position);
+
+// Function evaluate.
+// Returns tapered score of EvalState "eval" from the point of view of Color
+// "color".
+int evaluate(const EvalState& eval, Color color);
+
+
+#endif // EVALUATION_H_
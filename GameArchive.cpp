@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: GameArchive.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to GameArchive.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "GameArchive.h"
+
+// Constants of file format.
+static const char ARCHIVE_MAGIC[4] = {'C', 'G', 'A', '1'};
+static const unsigned ARCHIVE_VERSION = 1;
+static const int FILE_HEADER_SIZE = 24;
+static const int GAME_HEADER_SIZE = 4;
+static const int MAX_PLIES = 65535;
+static const int WRITE_BUFFER_SIZE = 512;
+
+// Functions put and get.
+// Write and read little endian number of "size" bytes.
+static void put(unsigned char* bytes, unsigned long long value, int size) {
+    for(int i=0; i<size; i++)
+        bytes[i] = static_cast<unsigned char>(value >> (8*i));
+}
+
+static unsigned long long get(const unsigned char* bytes, int size) {
+    unsigned long long value = 0;
+
+    for(int i=0; i<size; i++)
+        value |= static_cast<unsigned long long>(bytes[i]) << (8*i);
+    return value;
+}
+
+// Function string to result.
+GameResult string_to_result(string_view text) {
+    if(text == "1-0") return RESULT_WHITE_WINS;
+    if(text == "0-1") return RESULT_BLACK_WINS;
+    if(text == "1/2-1/2") return RESULT_DRAW;
+    return RESULT_UNKNOWN;
+}
+
+// Function result to string.
+const char* result_to_string(GameResult result) {
+    switch(result) {
+        case RESULT_WHITE_WINS: return "1-0";
+        case RESULT_BLACK_WINS: return "0-1";
+        case RESULT_DRAW: return "1/2-1/2";
+        default: return "*";
+    }
+}
+
+// Function archive move.
+Move archive_move(const MoveResult& result) {
+    int flags = 0;
+
+    if(result.captured != NO_PIECE) flags |= MOVE_FLAG_CAPTURE;
+    if(result.status == MOVE_CHECK || result.status == MOVE_CHECKMATE)
+        flags |= MOVE_FLAG_CHECK;
+    if(result.status == MOVE_CHECKMATE || result.status == MOVE_STALEMATE)
+        flags |= MOVE_FLAG_MATE;
+    return Move(square_index(result.start), square_index(result.end), flags);
+}
+
+// ArchiveGame
+// ===========
+Move ArchiveGame::move(int i) const {
+    return Move::from_data(get(moves + 2*i, 2));
+}
+
+// ArchiveWriter
+// =============
+// Constructor.
+ArchiveWriter::ArchiveWriter() {
+    position = 0;
+}
+
+// Destructor.
+ArchiveWriter::~ArchiveWriter() {
+    if(out.is_open()) close();
+}
+
+// Method: write
+void ArchiveWriter::write(const unsigned char* bytes, int size) {
+    out.write(reinterpret_cast<const char*>(bytes), size);
+    position += size;
+}
+
+// Method: open
+// Header is written with zeros now and filled in "close".
+bool ArchiveWriter::open(const char* path) {
+    unsigned char header[FILE_HEADER_SIZE] = {0};
+
+    out.open(path, ios::binary | ios::trunc);
+    if(!out) return false;
+
+    moves.clear();
+    offsets.clear();
+    position = 0;
+    write(header, FILE_HEADER_SIZE);
+    return static_cast<bool>(out);
+}
+
+// Method: add move
+void ArchiveWriter::add_move(Move move) {
+    moves.push_back(move);
+}
+
+// Method: end game
+// Games longer than 65535 plies can't be stored; their end is cut off.
+void ArchiveWriter::end_game(GameResult result) {
+    unsigned char header[GAME_HEADER_SIZE];
+    unsigned char buffer[WRITE_BUFFER_SIZE];
+    int plies = moves.size();
+    int length = 0;
+
+    if(plies > MAX_PLIES) plies = MAX_PLIES;
+
+    offsets.push_back(position);
+    put(header, plies, 2);
+    header[2] = static_cast<unsigned char>(result);
+    header[3] = 0;  // flags, not used yet
+    write(header, GAME_HEADER_SIZE);
+
+    for(int i=0; i<plies; i++) {
+        put(buffer + length, moves[i].get_data(), 2);
+        length += 2;
+        if(length == WRITE_BUFFER_SIZE) {
+            write(buffer, length);
+            length = 0;
+        }
+    }
+    write(buffer, length);
+    moves.clear();
+}
+
+// Method: close
+bool ArchiveWriter::close() {
+    unsigned char header[FILE_HEADER_SIZE];
+    unsigned char offset[8];
+    unsigned long long index = position;
+
+    for(size_t i=0; i<offsets.size(); i++) {
+        put(offset, offsets[i], 8);
+        write(offset, 8);
+    }
+
+    memcpy(header, ARCHIVE_MAGIC, 4);
+    put(header + 4, ARCHIVE_VERSION, 4);
+    put(header + 8, offsets.size(), 8);
+    put(header + 16, index, 8);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(header), FILE_HEADER_SIZE);
+
+    bool ok = static_cast<bool>(out);
+    out.close();
+    return ok;
+}
+
+// ArchiveReader
+// =============
+// Constructor.
+ArchiveReader::ArchiveReader() {
+    games = 0;
+    index = NULL;
+}
+
+// Method: open
+// Checks header and that index fits in file, so "get_game" only has to
+// check games themselves.
+bool ArchiveReader::open(const char* path) {
+    const unsigned char* data;
+    unsigned long long size, index_offset;
+
+    games = 0;
+    index = NULL;
+    if(!file.open(path)) return false;
+
+    data = reinterpret_cast<const unsigned char*>(file.get_data());
+    size = file.get_size();
+    if(size < FILE_HEADER_SIZE || memcmp(data, ARCHIVE_MAGIC, 4) != 0
+       || get(data + 4, 4) != ARCHIVE_VERSION) {
+        file.close();
+        return false;
+    }
+
+    games = get(data + 8, 8);
+    index_offset = get(data + 16, 8);
+    if(index_offset > size || (size - index_offset) / 8 < games) {
+        games = 0;
+        file.close();
+        return false;
+    }
+
+    index = data + index_offset;
+    return true;
+}
+
+// Method: size
+unsigned long long ArchiveReader::size() const {
+    return games;
+}
+
+// Method: get game
+bool ArchiveReader::get_game(unsigned long long i, ArchiveGame& game) const {
+    const unsigned char* data;
+    unsigned long long offset;
+
+    if(i >= games) return false;
+
+    data = reinterpret_cast<const unsigned char*>(file.get_data());
+    offset = get(index + 8*i, 8);
+    if(offset + GAME_HEADER_SIZE > file.get_size()) return false;
+
+    game.plies = get(data + offset, 2);
+    game.result = static_cast<GameResult>(data[offset + 2]);
+    game.moves = data + offset + GAME_HEADER_SIZE;
+    if(offset + GAME_HEADER_SIZE + 2ULL * game.plies > file.get_size())
+        return false;
+    return true;
+}
+
+// Method: replay
+int ArchiveReader::replay(unsigned long long i, ChessBoard& board) const {
+    ArchiveGame game;
+
+    board.resetBoard();
+    if(!get_game(i, game)) return 0;
+
+    for(int ply=0; ply<game.plies; ply++) {
+        Move move = game.move(ply);
+
+        if(!move_accepted(board.submitMove(move.start(), move.end()).status))
+            return ply;
+    }
+    return game.plies;
+}
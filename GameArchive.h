@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: GameArchive.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for binary archive of games. Every move is
+//              stored as its 16 bit Move (refer to Move.h), so game of 80
+//              moves takes 164 bytes instead of about 600 bytes of PGN, and
+//              is replayed without any parsing.
+//
+//              Layout of file (all numbers are little endian):
+//                  file header:  "CGA1", version (u32), number of games
+//                                (u64), offset of index (u64)
+//                  games:        for every game: plies (u16), result (u8),
+//                                flags (u8), then "plies" moves (u16 each)
+//                  index:        offset of every game (u64 each)
+//              Index is at the end, as writer knows it only when all games
+//              are written. With index any game can be read directly.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GAMEARCHIVE_H_
+#define GAMEARCHIVE_H_
+
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "ChessBoard.hpp"
+#include "MappedFile.h"
+
+using namespace std;
+
+
+// Enumerator: GameResult is result written at the end of game.
+enum GameResult {
+    RESULT_UNKNOWN,     // "*"
+    RESULT_WHITE_WINS,  // "1-0"
+    RESULT_BLACK_WINS,  // "0-1"
+    RESULT_DRAW         // "1/2-1/2"
+};
+
+// Functions that convert GameResult from and to PGN text. Unknown text is
+// RESULT_UNKNOWN.
+GameResult string_to_result(string_view text);
+const char* result_to_string(GameResult result);
+
+// Function archive move.
+// Packs move that was made on board, together with flags that tell if it
+// captured and if it gave check or mate.
+Move archive_move(const MoveResult& result);
+
+// STRUCT: ArchiveGame
+// ===================
+// One game in archive. "moves" points in mapped file; "move" unpacks i-th
+// move.
+struct ArchiveGame {
+    int plies;
+    GameResult result;
+    const unsigned char* moves;
+
+    Move move(int i) const;
+};
+
+// CLASS: ArchiveWriter
+// ====================
+// Usage:
+//     ArchiveWriter writer;
+//     writer.open("games.cga");
+//     ... for every move: writer.add_move(archive_move(result));
+//     writer.end_game(RESULT_WHITE_WINS);
+//     writer.close();
+// Moves of current game are kept in memory until "end_game". Offsets of
+// games are kept until "close", which writes index.
+class ArchiveWriter {
+private:
+    ofstream out;
+    vector<Move> moves;  // moves of current game
+    vector<unsigned long long> offsets;
+    unsigned long long position;  // bytes written so far
+
+    void write(const unsigned char* bytes, int size);
+
+public:
+    ArchiveWriter();
+    ~ArchiveWriter();
+
+    bool open(const char* path);
+    void add_move(Move move);
+    void end_game(GameResult result);
+
+    // Method close writes index and header. Returns false if anything
+    // couldn't be written.
+    bool close();
+};
+
+// CLASS: ArchiveReader
+// ====================
+// Reads archive through memory mapping. Reader is only read after "open",
+// so many threads can read the same archive.
+class ArchiveReader {
+private:
+    MappedFile file;
+    unsigned long long games;
+    const unsigned char* index;
+
+public:
+    ArchiveReader();
+
+    // Method open returns false if file can't be read or is not archive.
+    bool open(const char* path);
+
+    unsigned long long size() const;
+
+    // Method get game returns false if game "i" is out of range or is cut
+    // off.
+    bool get_game(unsigned long long i, ArchiveGame& game) const;
+
+    // Method replay resets "board" and plays game "i" on it. Returns number
+    // of moves played, which is less than number of moves in game if game
+    // has illegal move.
+    int replay(unsigned long long i, ChessBoard& board) const;
+};
+
+
+#endif // GAMEARCHIVE_H_
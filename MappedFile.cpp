@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: MappedFile.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to MappedFile.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "MappedFile.h"
+
+// Constructor.
+MappedFile::MappedFile() {
+    data = NULL;
+    size = 0;
+}
+
+// Destructor.
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Method: open
+// ============
+// File descriptor isn't needed once mapping exists, so it is closed right
+// away. Files are read from start to end, which we tell to kernel, so it
+// reads ahead.
+bool MappedFile::open(const char* path) {
+    struct stat info;
+    void* mapping;
+    int fd;
+
+    close();
+
+    fd = ::open(path, O_RDONLY);
+    if(fd < 0) return false;
+
+    if(fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if(info.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(mapping == MAP_FAILED) return false;
+
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(mapping);
+    size = info.st_size;
+    return true;
+}
+
+// Method: close
+// =============
+void MappedFile::close() {
+    if(data != NULL)
+        munmap(const_cast<char*>(data), size);
+    data = NULL;
+    size = 0;
+}
+
+// Getters.
+const char* MappedFile::get_data() const {
+    return data;
+}
+
+size_t MappedFile::get_size() const {
+    return size;
+}
+
+string_view MappedFile::get_view() const {
+    return string_view(data, size);
+}
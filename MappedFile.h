@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: MappedFile.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for class MappedFile, read-only memory mapping of
+//              whole file. Contents of file are read straight from page
+//              cache, without copying them in our own buffers. Mapping can be
+//              read by many threads at once.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstddef>
+#include <string_view>
+
+using namespace std;
+
+
+// CLASS: MappedFile
+// =================
+// Usage:
+//     MappedFile file;
+//     if(file.open("games.pgn")) {
+//         string_view text = file.get_view();
+//         ...
+//     }
+// Mapping is removed by "close" or by destructor. Object can't be copied,
+// as only one of the copies could remove mapping.
+class MappedFile {
+private:
+    const char* data;
+    size_t size;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Method open maps file "path". Returns false if file can't be opened.
+    // Empty file is opened successfully and has empty view.
+    bool open(const char* path);
+    void close();
+
+    const char* get_data() const;
+    size_t get_size() const;
+    string_view get_view() const;
+};
+
+
+#endif // MAPPEDFILE_H_
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Move.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for classes Move and MoveList. Move is compact
+//              representation of one move and MoveList is fixed size
+//              container of moves, that is filled by move generator
+//              (refer to MoveGen.h).
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOVE_H_
+#define MOVE_H_
+
+#include "Bitboard.h"
+#include "Square.h"
+
+
+// Maximum number of moves in one position. No legal chess position has more
+// than 218 moves, so 256 is always enough.
+const int MAX_MOVES = 256;
+
+// Move flags.
+const int MOVE_FLAG_CAPTURE = 1;  // move takes piece
+const int MOVE_FLAG_CHECK = 2;    // opponent is in check after move
+const int MOVE_FLAG_MATE = 4;     // opponent has no move after move
+
+// CLASS: Move
+// ===========
+// Move is packed in 16 bits: bits 0-5 hold index of starting square, bits
+// 6-11 hold index of ending square (refer to Bitboard.h for indices). Bits
+// 12-15 hold flags (MOVE_FLAG_*), which describe move but are not needed to
+// make it. Move generator leaves them 0; they are set where move is stored
+// (refer to GameArchive.h). Move with all bits 0 (A1 to A1) can never be
+// valid, so it is used as "no move".
+// Default constructor leaves move uninitialized, so arrays of moves (for
+// example MoveList) cost nothing to create; "no move" is made with
+// null_move.
+class Move {
+private:
+    unsigned short data;
+
+public:
+    // CONSTRUCTORS
+    // ============
+    Move() = default;
+    Move(int from, int to);
+    Move(int from, int to, int flags);
+    Move(Square start, Square end);
+
+    // Move from its 16 bits, for example read from file.
+    static Move from_data(unsigned short data);
+
+    // "No move".
+    static Move null_move();
+
+    // GET FUNCTIONS
+    // =============
+    int from() const;
+    int to() const;
+    int flags() const;
+    unsigned short get_data() const;
+    Square start() const;
+    Square end() const;
+    bool is_null() const;
+
+    // OPERATOR: ==
+    // ============
+    bool operator==(Move other) const;
+    bool operator!=(Move other) const;
+};
+
+// CLASS: MoveList
+// ===============
+// MoveList is array of MAX_MOVES moves with counter. It lives on stack, so
+// generating moves doesn't use heap at all.
+class MoveList {
+private:
+    Move moves[MAX_MOVES];
+    int count;
+
+public:
+    MoveList();
+
+    void add(Move move);
+    void clear();
+    int size() const;
+    Move operator[](int i) const;
+};
+
+// INLINE FUNCTIONS
+// ================
+// Moves are created and read for every generated move, so all functions
+// are inline.
+
+inline Move::Move(int from, int to)
+    : data(static_cast<unsigned short>(from | (to << 6))) {
+}
+
+inline Move::Move(int from, int to, int flags)
+    : data(static_cast<unsigned short>(from | (to << 6) | (flags << 12))) {
+}
+
+inline Move::Move(Square start, Square end)
+    : data(static_cast<unsigned short>(square_index(start)
+                                       | (square_index(end) << 6))) {
+}
+
+inline int Move::from() const {
+    return data & 63;
+}
+
+inline int Move::to() const {
+    return (data >> 6) & 63;
+}
+
+inline int Move::flags() const {
+    return data >> 12;
+}
+
+inline unsigned short Move::get_data() const {
+    return data;
+}
+
+inline Move Move::from_data(unsigned short data) {
+    Move move;
+    move.data = data;
+    return move;
+}
+
+inline Move Move::null_move() {
+    return from_data(0);
+}
+
+inline Square Move::start() const {
+    return index_square(from());
+}
+
+inline Square Move::end() const {
+    return index_square(to());
+}
+
+inline bool Move::is_null() const {
+    return data == 0;
+}
+
+inline bool Move::operator==(Move other) const {
+    return data == other.data;
+}
+
+inline bool Move::operator!=(Move other) const {
+    return data != other.data;
+}
+
+inline MoveList::MoveList() : count(0) {
+}
+
+inline void MoveList::add(Move move) {
+    moves[count++] = move;
+}
+
+inline void MoveList::clear() {
+    count = 0;
+}
+
+inline int MoveList::size() const {
+    return count;
+}
+
+inline Move MoveList::operator[](int i) const {
+    return moves[i];
+}
+
+
+#endif // MOVE_H_
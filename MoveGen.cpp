@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: MoveGen.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to MoveGen.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MoveGen.h"
+#include "Attacks.h"
+
+// Bitboards of rows 3 and 6. Pawn that made single step to these rows
+// started in pawn line, so it can make another step.
+static const Bitboard ROW_3 = 0x0000000000FF0000ULL;
+static const Bitboard ROW_6 = 0x0000FF0000000000ULL;
+
+// Bitboards of columns A and H. They are used to stop pawn captures from
+// wrapping around the board.
+static const Bitboard COLUMN_A = 0x0101010101010101ULL;
+static const Bitboard COLUMN_H = 0x8080808080808080ULL;
+
+// Function add moves.
+// Adds move from "from" to every square of "targets".
+static void add_moves(int from, Bitboard targets, MoveList& moves) {
+    while(targets)
+        moves.add(Move(from, pop_first_index(targets)));
+}
+
+// Function add shifted moves.
+// Used for pawns, where all targets are moved by the same "shift" from
+// their starting squares.
+static void add_shifted_moves(Bitboard targets, int shift, MoveList& moves) {
+    while(targets) {
+        int to = pop_first_index(targets);
+        moves.add(Move(to - shift, to));
+    }
+}
+
+// Function add pawn moves.
+// All pawns of one color are moved at once with shifting their bitboard.
+// White pawns move up (+8), black pawns move down (-8). Pawn moves two
+// squares only from pawn line and only if both squares are empty. Pawn
+// takes diagonally forward only. Bools "captures" and "quiets" tell which
+// of the two kinds of moves are added.
+static void add_pawn_moves(const Position& position, Color color,
+                           bool captures, bool quiets, MoveList& moves) {
+    Bitboard pawns = position.get_pieces(color, PAWN);
+    Bitboard empty = quiets ? ~position.get_occupied() : 0;
+    Bitboard enemy = captures ? position.get_occupancy(inverse_color(color))
+                              : 0;
+    Bitboard single, twice, left, right;
+
+    if(color == WHITE) {
+        single = (pawns << 8) & empty;
+        twice = ((single & ROW_3) << 8) & empty;
+        left = ((pawns & ~COLUMN_A) << 7) & enemy;
+        right = ((pawns & ~COLUMN_H) << 9) & enemy;
+        add_shifted_moves(single, 8, moves);
+        add_shifted_moves(twice, 16, moves);
+        add_shifted_moves(left, 7, moves);
+        add_shifted_moves(right, 9, moves);
+    }
+    else {
+        single = (pawns >> 8) & empty;
+        twice = ((single & ROW_6) >> 8) & empty;
+        left = ((pawns & ~COLUMN_A) >> 9) & enemy;
+        right = ((pawns & ~COLUMN_H) >> 7) & enemy;
+        add_shifted_moves(single, -8, moves);
+        add_shifted_moves(twice, -16, moves);
+        add_shifted_moves(left, -9, moves);
+        add_shifted_moves(right, -7, moves);
+    }
+}
+
+// Function add piece moves.
+// Adds moves of all pieces except pawns to squares of "allowed".
+static void add_piece_moves(const Position& position, Color color,
+                            Bitboard allowed, MoveList& moves) {
+    Bitboard occupied = position.get_occupied();
+
+    for(int type=KNIGHT; type<=KING; type++) {
+        Bitboard pieces = position.get_pieces(color,
+                                              static_cast<PieceType>(type));
+        while(pieces) {
+            int from = pop_first_index(pieces);
+            Bitboard targets = piece_attacks(static_cast<PieceType>(type),
+                                             from, occupied);
+            add_moves(from, targets & allowed, moves);
+        }
+    }
+}
+
+// Function generate moves.
+void generate_moves(const Position& position, Color color, MoveList& moves) {
+    add_pawn_moves(position, color, true, true, moves);
+    add_piece_moves(position, color, ~position.get_occupancy(color), moves);
+}
+
+// Function generate captures.
+void generate_captures(const Position& position, Color color,
+                       MoveList& moves) {
+    add_pawn_moves(position, color, true, false, moves);
+    add_piece_moves(position, color,
+                    position.get_occupancy(inverse_color(color)), moves);
+}
+
+// Function generate quiets.
+void generate_quiets(const Position& position, Color color, MoveList& moves) {
+    add_pawn_moves(position, color, false, true, moves);
+    add_piece_moves(position, color, ~position.get_occupied(), moves);
+}
+
+// Function is pseudo legal.
+// Checks the same rules as generator, but for one move only.
+bool is_pseudo_legal(const Position& position, Color color, Move move) {
+    int from = move.from();
+    int to = move.to();
+    Piece piece = position.piece_at(from);
+    Bitboard target = index_bit(to);
+
+    if(piece == NO_PIECE || piece_color(piece) != color) return false;
+    if(position.get_occupancy(color) & target) return false;
+
+    if(piece_type(piece) != PAWN) {
+        return (piece_attacks(piece_type(piece), from,
+                              position.get_occupied()) & target) != 0;
+    }
+
+    if(!position.is_empty(to))
+        return (pawn_attacks(color, from) & target) != 0;
+
+    int forward = (color == WHITE ? 8 : -8);
+    int pawn_line = (color == WHITE ? 1 : 6);
+
+    if(to == from + forward) return true;
+    return to == from + 2 * forward && from / 8 == pawn_line
+           && position.is_empty(from + forward);
+}
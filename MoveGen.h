@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: MoveGen.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for move generator. Move generator produces only
+//              moves that pieces can actually make, instead of trying every
+//              pair of squares.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOVEGEN_H_
+#define MOVEGEN_H_
+
+#include "Position.h"
+#include "Move.h"
+
+
+// Function generate_moves appends all pseudo-legal moves of pieces of Color
+// "color" in "position" to MoveList "moves". Pseudo-legal move follows
+// movement rules of the piece, doesn't jump over pieces (except knight) and
+// doesn't take piece of the same color. It can still leave own king in
+// chess; that is checked by ChessBoard.
+void generate_moves(const Position& position, Color color, MoveList& moves);
+
+// Functions generate_captures and generate_quiets append only part of the
+// same moves: moves that take piece and moves to empty squares. Together
+// they give all pseudo-legal moves. They are used by search, which often
+// doesn't need quiet moves at all (refer to MovePicker.h).
+void generate_captures(const Position& position, Color color,
+                       MoveList& moves);
+void generate_quiets(const Position& position, Color color, MoveList& moves);
+
+// Function is_pseudo_legal tells if Move "move" would be generated for Color
+// "color" in "position". It is used to check moves that didn't come from
+// generator (for example from transposition table).
+bool is_pseudo_legal(const Position& position, Color color, Move move);
+
+
+#endif // MOVEGEN_H_
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: MovePicker.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to MovePicker.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MovePicker.h"
+#include "MoveGen.h"
+#include "Evaluation.h"
+#include "See.h"
+
+// Score of move that was already given. It is lower than any real score.
+static const int USED_SCORE = -(1 << 30);
+
+// Constructor.
+MovePicker::MovePicker(const Position& _position, Color _color,
+                       Move _hash_move, const Move killer_moves[2],
+                       const int history_table[64][64])
+    : position(_position), color(_color), hash_move(_hash_move),
+      history(history_table) {
+    killers[0] = killer_moves[0];
+    killers[1] = killer_moves[1];
+    stage = STAGE_HASH_MOVE;
+    captures_only = false;
+    given = 0;
+    next_killer = 0;
+}
+
+// Constructor for quiescence search.
+MovePicker::MovePicker(const Position& _position, Color _color)
+    : position(_position), color(_color), hash_move(Move::null_move()),
+      history(NULL) {
+    killers[0] = killers[1] = Move::null_move();
+    stage = STAGE_GENERATE_CAPTURES;
+    captures_only = true;
+    given = 0;
+    next_killer = 0;
+}
+
+// Method: score captures
+// MVV-LVA: value of taken piece decides, value of piece that takes only
+// breaks ties (it is always smaller than the difference between victims).
+void MovePicker::score_captures() {
+    for(int i=0; i<moves.size(); i++) {
+        PieceType victim = position.type_at(moves[i].to());
+        PieceType attacker = position.type_at(moves[i].from());
+
+        scores[i] = 16 * PIECE_VALUES[victim] - attacker;
+    }
+}
+
+// Method: score quiets
+void MovePicker::score_quiets() {
+    for(int i=0; i<moves.size(); i++)
+        scores[i] = history[moves[i].from()][moves[i].to()];
+}
+
+// Method: pick best
+// Selection instead of sorting: list is rarely used to the end, so only
+// moves that are actually given are looked for.
+Move MovePicker::pick_best() {
+    int best = -1;
+
+    if(given == moves.size()) return Move::null_move();
+
+    for(int i=0; i<moves.size(); i++) {
+        if(scores[i] != USED_SCORE && (best < 0 || scores[i] > scores[best]))
+            best = i;
+    }
+    scores[best] = USED_SCORE;
+    given++;
+    return moves[best];
+}
+
+// Method: is bad capture
+// Capture of piece that is worth at least as much as the one that takes
+// can't lose material, so SEE is computed only for the rest.
+bool MovePicker::is_bad_capture(Move move) const {
+    PieceType victim = position.type_at(move.to());
+    PieceType attacker = position.type_at(move.from());
+
+    if(PIECE_VALUES[victim] >= PIECE_VALUES[attacker] && attacker != KING)
+        return false;
+    return see(position, move) < 0;
+}
+
+// Method: is special
+// Hash move and killers were given in their own stages.
+bool MovePicker::is_special(Move move) const {
+    return move == hash_move || move == killers[0] || move == killers[1];
+}
+
+// PUBLIC METHOD: next
+// ===================
+Move MovePicker::next() {
+    Move move;
+
+    switch(stage) {
+        case STAGE_HASH_MOVE:
+            stage = STAGE_GENERATE_CAPTURES;
+            if(!hash_move.is_null()
+               && is_pseudo_legal(position, color, hash_move))
+                return hash_move;
+            hash_move = Move::null_move();
+            // fall through
+        case STAGE_GENERATE_CAPTURES:
+            generate_captures(position, color, moves);
+            score_captures();
+            given = 0;
+            stage = STAGE_CAPTURES;
+            // fall through
+        case STAGE_CAPTURES:
+            while(!(move = pick_best()).is_null()) {
+                if(move == hash_move) continue;
+                if(!is_bad_capture(move)) return move;
+                if(!captures_only) bad_captures.add(move);
+            }
+            if(captures_only) {
+                stage = STAGE_DONE;
+                return Move::null_move();
+            }
+            stage = STAGE_KILLERS;
+            // fall through
+        case STAGE_KILLERS:
+            while(next_killer < 2) {
+                move = killers[next_killer++];
+                if(!move.is_null() && move != hash_move
+                   && position.is_empty(move.to())
+                   && is_pseudo_legal(position, color, move))
+                    return move;
+            }
+            stage = STAGE_GENERATE_QUIETS;
+            // fall through
+        case STAGE_GENERATE_QUIETS:
+            moves.clear();
+            generate_quiets(position, color, moves);
+            score_quiets();
+            given = 0;
+            stage = STAGE_QUIETS;
+            // fall through
+        case STAGE_QUIETS:
+            while(!(move = pick_best()).is_null()) {
+                if(!is_special(move)) return move;
+            }
+            given = 0;
+            stage = STAGE_BAD_CAPTURES;
+            // fall through
+        case STAGE_BAD_CAPTURES:
+            if(given < bad_captures.size())
+                return bad_captures[given++];
+            stage = STAGE_DONE;
+            // fall through
+        case STAGE_DONE:
+            break;
+    }
+    return Move::null_move();
+}
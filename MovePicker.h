@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: MovePicker.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for class MovePicker, which gives search moves
+//              of one position one by one, best looking first:
+//                  1. move from transposition table,
+//                  2. captures, most valuable victim first and among those
+//                     least valuable attacker first (MVV-LVA),
+//                  3. killer moves of this ply,
+//                  4. remaining quiet moves, ordered by history,
+//                  5. captures that lose material (refer to See.h).
+//              Moves are generated in stages: quiet moves are generated and
+//              scored only when all good captures were already given. Most
+//              nodes end with beta cutoff after first few moves, so they
+//              never generate quiet moves at all.
+//
+//              Quiescence search uses picker that gives only captures that
+//              don't lose material; losing captures are dropped.
+//
+//              Moves are pseudo-legal (refer to MoveGen.h); search checks
+//              whether move leaves own king in chess after making it.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOVEPICKER_H_
+#define MOVEPICKER_H_
+
+#include "Position.h"
+#include "Move.h"
+
+
+// CLASS: MovePicker
+// =================
+class MovePicker {
+private:
+    enum Stage {
+        STAGE_HASH_MOVE,
+        STAGE_GENERATE_CAPTURES,
+        STAGE_CAPTURES,
+        STAGE_KILLERS,
+        STAGE_GENERATE_QUIETS,
+        STAGE_QUIETS,
+        STAGE_BAD_CAPTURES,
+        STAGE_DONE
+    };
+
+    const Position& position;
+    Color color;
+    Move hash_move;
+    Move killers[2];
+    const int (*history)[64];  // history[from][to] of "color"
+
+    Stage stage;
+    bool captures_only;
+    MoveList moves;         // moves of current stage
+    MoveList bad_captures;  // captures that lose material
+    int scores[MAX_MOVES];  // scores[i] belongs to moves[i]
+    int given;              // moves of current stage given so far
+    int next_killer;
+
+    void score_captures();
+    void score_quiets();
+    Move pick_best();
+    bool is_bad_capture(Move move) const;
+    bool is_special(Move move) const;
+
+public:
+    // "killer_moves" are two killers of current ply and "history_table"
+    // history of "color"; both belong to the caller. Hash move and killers
+    // can be any moves (or "no move"); they are checked before they are
+    // given.
+    MovePicker(const Position& _position, Color _color, Move _hash_move,
+               const Move killer_moves[2], const int history_table[64][64]);
+
+    // Picker for quiescence search.
+    MovePicker(const Position& _position, Color _color);
+
+    // Returns next move or "no move" when there are no more.
+    Move next();
+};
+
+
+#endif // MOVEPICKER_H_
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Perft.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Perft tool. It counts all leaf nodes of move tree to given
+//              depth and prints how many of them are below every root move
+//              ("divide"). Numbers are compared with known results to check
+//              move generator, time is used to measure its speed.
+//
+//              Usage: perft <depth> [-threads N] [-hash MB] [-fen FEN]
+//                           [move ...]
+//              Counting starts from starting position or from position given
+//              as FEN (in quotes). Moves are in format [A-H][1-8][A-H][1-8]
+//              (e.g. E2E4) and are played before counting.
+//              Root moves are split between N threads. With -hash, counts
+//              of subtrees are cached in table of given size, shared by all
+//              threads. Positions are identified by Zobrist key.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+#include "ChessBoard.hpp"
+
+// TYPEDEFs
+// ========
+typedef unsigned long long Count;
+
+// Function mix.
+// Scrambles bits of "x" (splitmix64 finalizer).
+static unsigned long long mix(unsigned long long x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// CLASS: PerftHash
+// ================
+// Table of subtree counts, indexed by Zobrist key of position and depth.
+// Table is shared by threads without locks: entry keeps count and key XOR
+// count.
+// If other thread overwrites half of the entry in the middle of our read,
+// the XOR doesn't match and entry is treated as empty.
+class PerftHash {
+private:
+    struct Entry {
+        atomic<Key> check;  // key ^ count
+        atomic<Count> count;
+    };
+
+    vector<Entry> entries;
+    unsigned long long mask;
+
+    static Key depth_key(Key key, int depth);
+
+public:
+    // Table takes "megabytes" MB (rounded down to power of 2 entries).
+    PerftHash(int megabytes);
+
+    bool probe(Key key, int depth, Count& count);
+    void store(Key key, int depth, Count count);
+};
+
+// Constructor.
+PerftHash::PerftHash(int megabytes) {
+    unsigned long long size = 1;
+    unsigned long long bytes = static_cast<unsigned long long>(megabytes)
+                               * 1024 * 1024;
+
+    while(2 * size * sizeof(Entry) <= bytes)
+        size *= 2;
+
+    entries = vector<Entry>(size);
+    for(unsigned long long i=0; i<size; i++) {
+        entries[i].check = 0;
+        entries[i].count = 0;
+    }
+    mask = size - 1;
+}
+
+// Depth key.
+// Same position at different depth has different count, so depth is part
+// of the key.
+Key PerftHash::depth_key(Key key, int depth) {
+    return key ^ mix(depth);
+}
+
+// Probe.
+bool PerftHash::probe(Key key, int depth, Count& count) {
+    Key full_key = depth_key(key, depth);
+    Entry& entry = entries[full_key & mask];
+    Key check = entry.check.load(memory_order_relaxed);
+    Count stored = entry.count.load(memory_order_relaxed);
+
+    if((check ^ stored) != full_key) return false;
+    count = stored;
+    return true;
+}
+
+// Store.
+void PerftHash::store(Key key, int depth, Count count) {
+    Key full_key = depth_key(key, depth);
+    Entry& entry = entries[full_key & mask];
+
+    entry.check.store(full_key ^ count, memory_order_relaxed);
+    entry.count.store(count, memory_order_relaxed);
+}
+
+// Function perft.
+// Counts leaf nodes below current position of "board" at "depth".
+// "hash" can be NULL.
+static Count perft(ChessBoard& board, int depth, PerftHash* hash) {
+    MoveList moves;
+    Count nodes = 0;
+    Key key = 0;
+
+    if(depth == 0) return 1;
+
+    if(hash != NULL && depth > 1) {
+        key = board.get_key();
+        if(hash->probe(key, depth, nodes))
+            return nodes;
+    }
+
+    board.legal_moves(moves);
+    if(depth == 1) return moves.size();
+
+    for(int i=0; i<moves.size(); i++) {
+        MoveUndo undo;
+
+        board.make_move(moves[i].start(), moves[i].end(), undo);
+        board.pass_turn();
+        nodes += perft(board, depth-1, hash);
+        board.pass_turn();
+        board.unmake_move(moves[i].start(), moves[i].end(), undo);
+    }
+
+    if(hash != NULL && depth > 1)
+        hash->store(key, depth, nodes);
+    return nodes;
+}
+
+// Function divide worker.
+// Each thread takes next untaken root move, until there are none left.
+// Thread works on its own copy of board.
+static void divide_worker(ChessBoard board, const MoveList& moves, int depth,
+                          PerftHash* hash, atomic<int>& next,
+                          vector<Count>& counts) {
+    int i;
+
+    while((i = next.fetch_add(1)) < moves.size()) {
+        MoveUndo undo;
+
+        board.make_move(moves[i].start(), moves[i].end(), undo);
+        board.pass_turn();
+        counts[i] = perft(board, depth-1, hash);
+        board.pass_turn();
+        board.unmake_move(moves[i].start(), moves[i].end(), undo);
+    }
+}
+
+// Function play move.
+// Finds legal move written as "E2E4" and plays it. Returns false if
+// move is written wrong or isn't legal.
+static bool play_move(ChessBoard& board, string_view move_str) {
+    Square start, end;
+    MoveList moves;
+
+    if(move_str.length() != 4
+       || !string_to_square(move_str.substr(0, 2), start)
+       || !string_to_square(move_str.substr(2, 2), end))
+        return false;
+
+    board.legal_moves(moves);
+    for(int i=0; i<moves.size(); i++) {
+        if(moves[i] == Move(start, end)) {
+            MoveUndo undo;
+            board.make_move(start, end, undo);
+            board.pass_turn();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Function print usage.
+static void print_usage() {
+    cerr << "Usage: perft <depth> [-threads N] [-hash MB] [-fen FEN]"
+         << " [move ...]" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int depth, threads = 1, hash_mb = 0;
+    ChessBoard board(NULL);
+    MoveList moves;
+    PerftHash* hash = NULL;
+
+    if(argc < 2 || (depth = atoi(argv[1])) < 1) {
+        print_usage();
+        return 1;
+    }
+
+    for(int i=2; i<argc; i++) {
+        string arg = argv[i];
+
+        if(arg == "-threads" && i+1 < argc) {
+            threads = atoi(argv[++i]);
+            if(threads < 1) threads = 1;
+        }
+        else if(arg == "-hash" && i+1 < argc) {
+            hash_mb = atoi(argv[++i]);
+        }
+        else if(arg == "-fen" && i+1 < argc) {
+            if(!board.from_fen(argv[++i])) {
+                cerr << "Invalid FEN " << argv[i] << "!" << endl;
+                return 1;
+            }
+        }
+        else if(!play_move(board, arg)) {
+            cerr << "Illegal move " << arg << "!" << endl;
+            return 1;
+        }
+    }
+
+    if(hash_mb > 0)
+        hash = new PerftHash(hash_mb);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    board.legal_moves(moves);
+    vector<Count> counts(moves.size(), 0);
+    atomic<int> next(0);
+    vector<thread> workers;
+
+    for(int i=0; i<threads; i++) {
+        workers.push_back(thread(divide_worker, board, cref(moves), depth,
+                                 hash, ref(next), ref(counts)));
+    }
+    for(int i=0; i<threads; i++)
+        workers[i].join();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                              - start).count();
+    Count total = 0;
+
+    for(int i=0; i<moves.size(); i++) {
+        cout << moves[i].start() << moves[i].end() << ": " << counts[i]
+             << "\n";
+        total += counts[i];
+    }
+
+    cout << "\n";
+    cout << "Moves: " << moves.size() << "\n";
+    cout << "Nodes: " << total << "\n";
+    cout << "Time: " << seconds << " s\n";
+    if(seconds > 0)
+        cout << "Speed: " << static_cast<Count>(total / seconds)
+             << " nodes/s\n";
+
+    delete hash;
+    return 0;
+}
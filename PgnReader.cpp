@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: PgnReader.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to PgnReader.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cctype>
+#include <cstring>
+
+#include "PgnReader.h"
+#include "San.h"
+
+// Function copy string.
+// Copies "from" to "to" of size "size", cutting it if it is too long.
+static void copy_string(char* to, const char* from, int size) {
+    int i;
+
+    for(i=0; i<size-1 && from[i] != '\0'; i++)
+        to[i] = from[i];
+    to[i] = '\0';
+}
+
+// Function is result.
+static bool is_result(const char* token) {
+    return strcmp(token, "1-0") == 0 || strcmp(token, "0-1") == 0
+        || strcmp(token, "1/2-1/2") == 0 || strcmp(token, "*") == 0;
+}
+
+// Function is delimiter.
+// Characters that end move token even without space before them.
+static bool is_delimiter(int c) {
+    return c == EOF || isspace(c) || strchr("{}();[]$", c) != NULL;
+}
+
+// PgnVisitor
+// ==========
+PgnVisitor::~PgnVisitor() {
+}
+
+void PgnVisitor::tag(const char*, const char*) {
+}
+
+void PgnVisitor::start(const ChessBoard&) {
+}
+
+void PgnVisitor::move(const MoveResult&) {
+}
+
+// Constructors.
+PgnReader::PgnReader(istream& _in, long long limit) {
+    in = &_in;
+    current = buffer;
+    end = buffer;
+    remaining = limit;
+    games = 0;
+}
+
+PgnReader::PgnReader(string_view text) {
+    in = NULL;
+    current = text.data();
+    end = text.data() + text.size();
+    remaining = 0;
+    games = 0;
+}
+
+// Method: refill
+// ==============
+bool PgnReader::refill() {
+    long long size = PGN_BUFFER_SIZE;
+
+    if(in == NULL) return false;
+
+    if(remaining != -1 && remaining < size) size = remaining;
+    if(size == 0) return false;
+
+    in->read(buffer, size);
+    current = buffer;
+    end = buffer + in->gcount();
+    if(remaining != -1) remaining -= in->gcount();
+    return current < end;
+}
+
+// Methods: peek, get
+// ==================
+int PgnReader::peek() {
+    if(current == end && !refill()) return EOF;
+    return static_cast<unsigned char>(*current);
+}
+
+int PgnReader::get() {
+    if(current == end && !refill()) return EOF;
+    return static_cast<unsigned char>(*current++);
+}
+
+// Methods: skip_space, skip_line, skip_comment, skip_variation
+// ============================================================
+void PgnReader::skip_space() {
+    while(peek() != EOF && isspace(peek()))
+        get();
+}
+
+void PgnReader::skip_line() {
+    int c;
+    while((c = get()) != EOF && c != '\n');
+}
+
+// Comment in braces ends with first closing brace; they don't nest.
+void PgnReader::skip_comment() {
+    int c;
+    while((c = get()) != EOF && c != '}');
+}
+
+// Variations can nest and can hold comments, which can hold parentheses.
+void PgnReader::skip_variation() {
+    int depth = 1;
+    int c;
+
+    get();  // '('
+    while(depth > 0 && (c = peek()) != EOF) {
+        if(c == '{') skip_comment();
+        else if(c == ';') skip_line();
+        else {
+            get();
+            if(c == '(') depth++;
+            if(c == ')') depth--;
+        }
+    }
+}
+
+// Method: read_tag
+// ================
+// Tag value is in quotes, where \" and \\ stand for " and \.
+void PgnReader::read_tag(char* name, char* value) {
+    int length = 0;
+    int c;
+
+    get();  // '['
+    skip_space();
+    while((c = peek()) != EOF && !isspace(c) && c != '"' && c != ']') {
+        get();
+        if(length < PGN_TAG_SIZE - 1) name[length++] = c;
+    }
+    name[length] = '\0';
+
+    length = 0;
+    skip_space();
+    if(peek() == '"') {
+        get();
+        while((c = get()) != EOF && c != '"') {
+            if(c == '\\' && peek() != EOF) c = get();
+            if(length < PGN_TAG_SIZE - 1) value[length++] = c;
+        }
+    }
+    value[length] = '\0';
+
+    while((c = get()) != EOF && c != ']');
+}
+
+// Method: read_token
+// ==================
+void PgnReader::read_token(char* token, int size) {
+    int length = 0;
+
+    while(!is_delimiter(peek())) {
+        int c = get();
+        if(length < size - 1) token[length++] = c;
+    }
+    token[length] = '\0';
+}
+
+// Method: play_move
+// =================
+void PgnReader::play_move(ChessBoard& board, PgnGame& game, const char* san,
+                          PgnVisitor* visitor) {
+    Move move;
+
+    if(!game.ok) return;
+
+    if(!decode_san(board, san, move)) {
+        game.ok = false;
+        game.error = "illegal move";
+        copy_string(game.error_move, san, PGN_MOVE_SIZE);
+        return;
+    }
+
+    MoveResult result = board.submitMove(move.start(), move.end());
+    if(!move_accepted(result.status)) {
+        game.ok = false;
+        game.error = "illegal move";
+        copy_string(game.error_move, san, PGN_MOVE_SIZE);
+        return;
+    }
+
+    game.plies++;
+    game.status = result.status;
+    if(visitor != NULL) visitor->move(result);
+}
+
+// PUBLIC METHOD: read_game
+// ========================
+// Game ends with result. If result is missing, game ends where next game's
+// tags start or at the end of input.
+bool PgnReader::read_game(ChessBoard& board, PgnGame& game,
+                          PgnVisitor* visitor) {
+    char name[PGN_TAG_SIZE], value[PGN_TAG_SIZE];
+    char token[PGN_MOVE_SIZE];
+    bool started = false;   // anything of this game was read
+    bool in_moves = false;  // movetext of this game was reached
+    int c;
+
+    board.resetBoard();
+    game.number = games + 1;
+    game.plies = 0;
+    game.ok = true;
+    game.from_fen = false;
+    game.error = NULL;
+    game.error_move[0] = '\0';
+    game.result[0] = '\0';
+    game.status = MOVE_OK;
+
+    while(true) {
+        skip_space();
+        c = peek();
+
+        if(c == EOF) break;
+
+        if(c == '[') {
+            if(in_moves) break;  // next game without result in this one
+            read_tag(name, value);
+            if(strcmp(name, "FEN") == 0 && game.ok) {
+                game.from_fen = true;
+                if(!board.from_fen(value)) {
+                    game.ok = false;
+                    game.error = "invalid FEN";
+                }
+            }
+            if(visitor != NULL) visitor->tag(name, value);
+            started = true;
+            continue;
+        }
+
+        if(c == '{') skip_comment();
+        else if(c == ';' || c == '%') skip_line();
+        else if(c == '(') skip_variation();
+        else if(c == ')' || c == ']' || c == '}') get();  // stray character
+        else if(c == '$') {
+            get();
+            read_token(token, PGN_MOVE_SIZE);
+        }
+        else {
+            read_token(token, PGN_MOVE_SIZE);
+            if(!in_moves && visitor != NULL) visitor->start(board);
+            started = true;
+            in_moves = true;
+
+            if(is_result(token)) {
+                copy_string(game.result, token, sizeof(game.result));
+                break;
+            }
+
+            // Move number ("12." or "12...") can be glued to move ("12.e4").
+            const char* san = token;
+            while(isdigit(*san)) san++;
+            if(*san != '.') san = token;
+            while(*san == '.') san++;
+
+            if(*san != '\0') play_move(board, game, san, visitor);
+        }
+    }
+
+    if(!started) return false;
+    games++;
+    return true;
+}
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: PgnReader.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for streaming reader of PGN (Portable Game
+//              Notation) files. Reader goes through input once, in chunks of
+//              fixed size, and plays moves of every game on ChessBoard as
+//              soon as it reads them. Game is never stored as a whole, so
+//              memory used doesn't depend on size of file or of games.
+//
+//              Reader understands tag pairs ([Event "..."]), move numbers,
+//              SAN moves, comments ({...} and ;...), variations ((...)),
+//              NAGs ($1) and game results (1-0, 0-1, 1/2-1/2, *).
+//              Variations are skipped, only main line is played. Game with
+//              [FEN "..."] tag starts from position of that tag.
+//
+//              Reader reads either from stream or straight from memory (for
+//              example file mapped with MappedFile). In the latter case
+//              nothing is copied, except single moves in small buffer on
+//              stack.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PGNREADER_H_
+#define PGNREADER_H_
+
+#include <iostream>
+#include <string_view>
+
+#include "ChessBoard.hpp"
+
+using namespace std;
+
+
+// Sizes of fixed buffers. Longer tag names, values and moves are cut.
+const int PGN_BUFFER_SIZE = 1 << 16;
+const int PGN_TAG_SIZE = 256;
+const int PGN_MOVE_SIZE = 32;
+
+// STRUCT: PgnGame
+// ===============
+// Summary of one game that was read.
+//    - number: 1 for first game in input, 2 for second, ...
+//    - plies: number of moves that were played.
+//    - ok: true if starting position and all moves of the game were legal.
+//    - from_fen: game started from position of FEN tag.
+//    - error: what went wrong ("illegal move" or "invalid FEN"), NULL if ok.
+//    - error_move: first move that couldn't be played (empty if ok or if
+//      FEN was invalid).
+//    - result: result written at the end of game (empty if missing).
+//    - status: status of last move that was played.
+struct PgnGame {
+    int number;
+    int plies;
+    bool ok;
+    bool from_fen;
+    const char* error;
+    char error_move[PGN_MOVE_SIZE];
+    char result[8];
+    MoveStatus status;
+};
+
+// CLASS: PgnVisitor
+// =================
+// Interface for receiving contents of game while it is read. All methods are
+// empty by default.
+//    - tag: tag pair was read. Strings are valid only during call.
+//    - start: movetext of game was reached, "board" is in starting position
+//      of the game (after FEN tag, if any).
+//    - move: move was played on board.
+class PgnVisitor {
+public:
+    virtual ~PgnVisitor();
+
+    virtual void tag(const char* name, const char* value);
+    virtual void start(const ChessBoard& board);
+    virtual void move(const MoveResult& result);
+};
+
+// CLASS: PgnReader
+// ================
+// Usage:
+//     ifstream file("games.pgn");
+//     PgnReader reader(file);
+//     ChessBoard board(NULL);
+//     PgnGame game;
+//     while(reader.read_game(board, game)) { ... }
+class PgnReader {
+private:
+    istream* in;          // NULL when reading from memory
+    char buffer[PGN_BUFFER_SIZE];
+    const char* current;  // next character to read
+    const char* end;      // end of characters in buffer
+    long long remaining;  // characters that may still be read, -1 for all
+    int games;            // games read so far
+
+    // Method refill reads next chunk of input. Returns false at end of input.
+    bool refill();
+
+    // Methods peek and get return next character (or EOF). Get also moves
+    // past it.
+    int peek();
+    int get();
+
+    // Methods that skip parts of PGN we don't use.
+    void skip_space();
+    void skip_line();
+    void skip_comment();
+    void skip_variation();
+
+    // Method read tag reads "[Name "Value"]".
+    void read_tag(char* name, char* value);
+
+    // Method read token reads everything up to space or special character.
+    void read_token(char* token, int size);
+
+    // Method play move decodes "san" and plays it, if game is still ok.
+    void play_move(ChessBoard& board, PgnGame& game, const char* san,
+                   PgnVisitor* visitor);
+
+public:
+    // Constructor. Reader reads at most "limit" characters from current
+    // position of "_in" (everything if "limit" is -1), which allows more
+    // readers to share one file, each reading its own part.
+    PgnReader(istream& _in, long long limit = -1);
+
+    // Constructor for reading from memory. "text" must stay valid while
+    // reader is used.
+    PgnReader(string_view text);
+
+    // PUBLIC METHOD: read_game
+    // ========================
+    // Reads next game from input, playing its moves on "board" (board is
+    // reset first, or set from FEN tag). Summary of game is written to
+    // "game". Reading continues after illegal move or invalid FEN up to the
+    // end of game, so next game can be read.
+    // "visitor" can be NULL.
+    // Returns false if there are no more games.
+    bool read_game(ChessBoard& board, PgnGame& game,
+                   PgnVisitor* visitor = NULL);
+};
+
+
+#endif // PGNREADER_H_
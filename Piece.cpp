@@ -0,0 +1,31 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Piece.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Piece.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Piece.h"
+
+
+// Color_to_string.
+string color_to_string(Color color) {
+    return (color == WHITE ? "White" : "Black");
+}
+
+// Print function.
+void print_piece_ascii(ostream& outs, Piece piece) {
+    char side_char;
+
+    side_char = (piece_color(piece) == WHITE ? ' ' : '=');
+    outs << side_char;
+    outs << PIECE_SYMBOLS[piece];
+    outs << side_char;
+}
+
+// Print name.
+void print_piece_name(ostream& outs, Piece piece) {
+    outs << color_to_string(piece_color(piece));
+    outs << "'s ";
+    outs << PIECE_NAMES[piece];
+}
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Piece.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for compact representation of chess pieces.
+//              Piece is small number (piece code) that holds color and type
+//              of piece. Everything else about piece (symbol, name, does it
+//              jump, how does it move) is stored in constant tables indexed
+//              by piece code. Pieces are therefore plain values: they are
+//              never allocated and are copied as one byte.
+//              As support this file also holds enumerators Color and
+//              PieceType.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PIECE_H_
+#define PIECE_H_
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+
+// Enumerator: Color that is used to mark color of chess pieces.
+enum Color {
+    WHITE,
+    BLACK
+};
+
+// Enumerator: PieceType that is used to mark type of chess pieces.
+// NO_PIECE_TYPE marks empty square.
+enum PieceType {
+    PAWN,
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN,
+    KING,
+    NO_PIECE_TYPE
+};
+
+// Enumerator: Piece is piece code, stored in one byte. Bit 3 holds color,
+// bits 0-2 hold type.
+// NO_PIECE marks empty square.
+enum Piece : unsigned char {
+    WHITE_PAWN = 0, WHITE_KNIGHT, WHITE_BISHOP, WHITE_ROOK, WHITE_QUEEN,
+    WHITE_KING, NO_PIECE,
+    BLACK_PAWN = 8, BLACK_KNIGHT, BLACK_BISHOP, BLACK_ROOK, BLACK_QUEEN,
+    BLACK_KING
+};
+
+// Number of piece codes. Tables indexed by piece code have this size.
+const int PIECE_CODES = 16;
+
+// Function that Color "color" as input and inverts it.
+// It turns WHITE in BLACK and vice versa.
+inline Color inverse_color(Color color) {
+    return (color == WHITE ? BLACK : WHITE);
+}
+
+// Function that takes color and returns it's string representation.
+// For example WHITE gets converted to "White".
+string color_to_string(Color color);
+
+// Functions that convert between piece code and (color, type).
+inline constexpr Piece make_piece(Color color, PieceType type) {
+    return static_cast<Piece>((color << 3) | type);
+}
+
+inline constexpr Color piece_color(Piece piece) {
+    return static_cast<Color>(piece >> 3);
+}
+
+inline constexpr PieceType piece_type(Piece piece) {
+    return static_cast<PieceType>(piece & 7);
+}
+
+// TABLES
+// ======
+// Symbol, that is used to represent piece on ASCII board.
+inline constexpr char PIECE_SYMBOLS[PIECE_CODES] = {
+    'P', 'N', 'B', 'R', 'Q', 'K', ' ', ' ',
+    'P', 'N', 'B', 'R', 'Q', 'K', ' ', ' '
+};
+
+// Name of the piece.
+inline constexpr const char* PIECE_NAMES[PIECE_CODES] = {
+    "Pawn", "Knight", "Bishop", "Rook", "Queen", "King", "", "",
+    "Pawn", "Knight", "Bishop", "Rook", "Queen", "King", "", ""
+};
+
+// Does piece jump. It is true for knight only.
+inline constexpr bool PIECE_JUMPS[PIECE_CODES] = {
+    false, true, false, false, false, false, false, false,
+    false, true, false, false, false, false, false, false
+};
+
+// Move rules. For every piece code and every move (dx, dy), where both are
+// between -7 and 7, table holds flags:
+//    - RULE_MOVE: piece can make this move to empty square,
+//    - RULE_EAT: piece can make this move if it takes piece,
+//    - RULE_FIRST: move is allowed only from pawn line.
+// Table tells only if piece moves this way on EMPTY board. Pieces in the way
+// are checked by ChessBoard.
+const unsigned char RULE_MOVE = 1;
+const unsigned char RULE_EAT = 2;
+const unsigned char RULE_FIRST = 4;
+
+struct MoveRules {
+    unsigned char rules[PIECE_CODES][15][15];  // rules[piece][dx+7][dy+7]
+};
+
+// Function piece rule.
+// Computes flags of one move. Pawn moves forward, which is up for white
+// and down for black.
+constexpr unsigned char piece_rule(Piece piece, int dx, int dy) {
+    int adx = (dx < 0 ? -dx : dx);
+    int ady = (dy < 0 ? -dy : dy);
+    bool line = (dx == 0 || dy == 0);
+    bool diagonal = (adx == ady);
+    const unsigned char ANY = RULE_MOVE | RULE_EAT;
+
+    if(dx == 0 && dy == 0) return 0;  // not moving
+
+    switch(piece_type(piece)) {
+        case KING: return (adx <= 1 && ady <= 1) ? ANY : 0;
+        case QUEEN: return (line || diagonal) ? ANY : 0;
+        case ROOK: return line ? ANY : 0;
+        case BISHOP: return diagonal ? ANY : 0;
+        case KNIGHT:
+            return ((adx == 1 && ady == 2) || (adx == 2 && ady == 1)) ? ANY : 0;
+        case PAWN: {
+            int forward = (piece_color(piece) == WHITE ? dy : -dy);
+            if(dx == 0 && forward == 1) return RULE_MOVE;
+            if(dx == 0 && forward == 2) return RULE_MOVE | RULE_FIRST;
+            if(adx == 1 && forward == 1) return RULE_EAT;  // eat side-ways
+            return 0;
+        }
+        default: return 0;
+    }
+}
+
+// Function make move rules.
+constexpr MoveRules make_move_rules() {
+    MoveRules table = {};
+
+    for(int piece=0; piece<PIECE_CODES; piece++) {
+        for(int dx=-7; dx<=7; dx++) {
+            for(int dy=-7; dy<=7; dy++) {
+                table.rules[piece][dx+7][dy+7] =
+                    piece_rule(static_cast<Piece>(piece), dx, dy);
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr MoveRules MOVE_RULES = make_move_rules();
+
+// Function is valid piece move.
+// Tells if Piece "piece" can move by (dx, dy). Bool "eats" tells whether
+// piece takes another piece with this move and "first" tells whether piece
+// starts in pawn line. Both bools only influence movement of pawn.
+inline bool is_valid_piece_move(Piece piece, int dx, int dy,
+                                bool eats, bool first) {
+    unsigned char rule = MOVE_RULES.rules[piece][dx+7][dy+7];
+
+    if(!(rule & (eats ? RULE_EAT : RULE_MOVE))) return false;
+    if((rule & RULE_FIRST) && !first) return false;
+    return true;
+}
+
+// PRINT FUNCTIONS
+// ===============
+// "print_piece_ascii" prints ASCII representation. For example =P= for
+// black pawn. Another example would be  K  for white king.
+// "print_piece_name" prints piece's name. For example: Black's Pawn.
+void print_piece_ascii(ostream& outs, Piece piece);
+void print_piece_name(ostream& outs, Piece piece);
+
+
+#endif // PIECE_H_
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Position.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Position.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Position.h"
+
+
+// Basic constructor.
+Position::Position() {
+    clear();
+}
+
+// Method: clear
+void Position::clear() {
+    for(int color=0; color<2; color++) {
+        for(int type=0; type<6; type++)
+            pieces[color][type] = 0;
+        occupancy[color] = 0;
+    }
+    occupied = 0;
+    for(int index=0; index<64; index++)
+        squares[index] = NO_PIECE;
+}
+
+// Method: put piece
+void Position::put_piece(Color color, PieceType type, int index) {
+    Bitboard bit = index_bit(index);
+
+    pieces[color][type] |= bit;
+    occupancy[color] |= bit;
+    occupied |= bit;
+    squares[index] = make_piece(color, type);
+}
+
+// Method: remove piece
+void Position::remove_piece(int index) {
+    Bitboard bit = index_bit(index);
+    Color color = color_at(index);
+
+    pieces[color][type_at(index)] &= ~bit;
+    occupancy[color] &= ~bit;
+    occupied &= ~bit;
+    squares[index] = NO_PIECE;
+}
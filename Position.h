@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Position.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for class Position. Position stores placement of
+//              chess pieces with bitboards. It is the main container of class
+//              ChessBoard. For more info refer to class Position description.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POSITION_H_
+#define POSITION_H_
+
+#include "Bitboard.h"
+#include "Piece.h"
+
+
+// CLASS: Position
+// ===============
+// Class Position represents placement of pieces on the board. It keeps one
+// bitboard for every piece type of every color ("pieces"), one bitboard with
+// all pieces of each color ("occupancy") and one bitboard with all pieces on
+// the board ("occupied"). To answer "what is on this square" without looking
+// through bitboards, it also keeps piece code of every square ("squares").
+// All containers are kept in sync by "put_piece" and "remove_piece", which
+// are the only two methods that change position.
+//
+// Squares are adressed with bit index (refer to Bitboard.h). Position doesn't
+// know anything about chess rules. That is the job of class ChessBoard.
+//
+// Position has no pointers, so it can be freely copied and assigned. Copy is
+// plain copy of memory.
+class Position {
+private:
+    // MAIN CONTAINERS
+    // ===============
+    Bitboard pieces[2][6];  // pieces[color][type]
+    Bitboard occupancy[2];  // occupancy[color]
+    Bitboard occupied;      // all pieces
+    Piece squares[64];      // squares[index]
+
+public:
+    // CONSTRUCTORS / DESTRUCTORS
+    // ==========================
+    // New position is empty.
+    Position();
+
+    // SET FUNCTIONS
+    // =============
+    // "clear" removes all pieces from the board. "put_piece" puts piece on
+    // empty square "index" and "remove_piece" removes piece from non-empty
+    // square "index".
+    void clear();
+    void put_piece(Color color, PieceType type, int index);
+    void remove_piece(int index);
+
+    // GET FUNCTIONS
+    // =============
+    // "color_at" and "type_at" should be called on non-empty squares only.
+    // For empty square "type_at" returns NO_PIECE_TYPE and "piece_at"
+    // returns NO_PIECE.
+    bool is_empty(int index) const;
+    Piece piece_at(int index) const;
+    Color color_at(int index) const;
+    PieceType type_at(int index) const;
+    Bitboard get_pieces(Color color, PieceType type) const;
+    Bitboard get_occupancy(Color color) const;
+    Bitboard get_occupied() const;
+};
+
+// INLINE FUNCTIONS
+// ================
+// Get functions are called for every square we look at, so they are inline.
+
+inline bool Position::is_empty(int index) const {
+    return !(occupied & index_bit(index));
+}
+
+inline Piece Position::piece_at(int index) const {
+    return squares[index];
+}
+
+inline Color Position::color_at(int index) const {
+    return piece_color(squares[index]);
+}
+
+inline PieceType Position::type_at(int index) const {
+    return piece_type(squares[index]);
+}
+
+inline Bitboard Position::get_pieces(Color color, PieceType type) const {
+    return pieces[color][type];
+}
+
+inline Bitboard Position::get_occupancy(Color color) const {
+    return occupancy[color];
+}
+
+inline Bitboard Position::get_occupied() const {
+    return occupied;
+}
+
+
+#endif // POSITION_H_
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: San.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to San.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "San.h"
+
+// Maximum length of SAN we accept. Longest valid SAN ("Qh4xe1=Q+") is much
+// shorter.
+static const int MAX_SAN = 16;
+
+// Function piece letter type.
+// Converts piece letter of SAN to PieceType. Returns NO_PIECE_TYPE if
+// "letter" isn't piece letter.
+static PieceType piece_letter_type(char letter) {
+    switch(letter) {
+        case 'N': return KNIGHT;
+        case 'B': return BISHOP;
+        case 'R': return ROOK;
+        case 'Q': return QUEEN;
+        case 'K': return KING;
+        default: return NO_PIECE_TYPE;
+    }
+}
+
+// Function decode san.
+// SAN is parsed from both ends: piece letter is at the start, ending square
+// is at the end, and whatever is left in between (column and/or row of
+// starting square) is used to choose between more pieces that could move.
+bool decode_san(ChessBoard& board, string_view san, Move& move) {
+    char text[MAX_SAN];
+    int length = 0;
+    PieceType type = PAWN;
+    int from_x = -1, from_y = -1, to_x, to_y;
+    MoveList moves;
+    int matches = 0;
+
+    // Copy SAN without capture marks, dashes and everything after end of move.
+    for(size_t i=0; i<san.size(); i++) {
+        char c = san[i];
+
+        if(c == 'x' || c == ':' || c == '-') continue;
+        if(c == '+' || c == '#' || c == '!' || c == '?') break;
+        if(c == 'e' && i+1 < san.size() && san[i+1] == '.') break;  // "e.p."
+        if(length == MAX_SAN - 1) return false;
+        text[length++] = c;
+    }
+    text[length] = '\0';
+
+    if(length < 2) return false;
+    if(text[0] == 'O' || text[0] == '0') return false;  // castling
+    if(strchr(text, '=') != NULL) return false;  // promotion
+
+    // Piece letter.
+    int first = 0;
+    if(piece_letter_type(text[0]) != NO_PIECE_TYPE) {
+        type = piece_letter_type(text[0]);
+        first = 1;
+    }
+
+    // Ending square.
+    to_x = text[length-2] - 'a';
+    to_y = text[length-1] - '1';
+    if(to_x < 0 || 7 < to_x || to_y < 0 || 7 < to_y) return false;
+
+    // Column and row of starting square, if given.
+    for(int i=first; i<length-2; i++) {
+        if('a' <= text[i] && text[i] <= 'h') from_x = text[i] - 'a';
+        else if('1' <= text[i] && text[i] <= '8') from_y = text[i] - '1';
+        else return false;
+    }
+
+    board.legal_moves(moves);
+    for(int i=0; i<moves.size(); i++) {
+        Square start = moves[i].start();
+        Square end = moves[i].end();
+
+        if(end.x != to_x || end.y != to_y) continue;
+        if(board.get_position().type_at(moves[i].from()) != type) continue;
+        if(from_x != -1 && start.x != from_x) continue;
+        if(from_y != -1 && start.y != from_y) continue;
+
+        move = moves[i];
+        matches++;
+    }
+    return matches == 1;
+}
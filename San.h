@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: San.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for decoding moves written in Standard Algebraic
+//              Notation (SAN), as used in PGN files. For example "e4",
+//              "Nf3", "exd5", "Rad1", "N5xf3+" or "Qh4e1#".
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SAN_H_
+#define SAN_H_
+
+#include <string_view>
+
+#include "ChessBoard.hpp"
+
+
+// Function decode san.
+// Finds legal move of player on turn in "board" that is written as "san".
+// Long notation with starting square ("e2e4", "Ng1-f3") is also accepted.
+// Check, mate and annotation marks (+ # ! ?) are ignored.
+// If exactly one legal move matches, it is written in "move" and function
+// returns true. Function returns false if no move or more moves match.
+// NOTE: this engine doesn't know castling and promotion, so moves like
+//       "O-O" or "e8=Q" are never decoded.
+bool decode_san(ChessBoard& board, string_view san, Move& move);
+
+
+#endif // SAN_H_
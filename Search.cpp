@@ -0,0 +1,584 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Search.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Search.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+
+#include "Search.h"
+#include "Evaluation.h"
+#include "MovePicker.h"
+
+// Time and node limits are checked once in this many nodes, as reading
+// clock and adding nodes of all threads is slow compared to one node.
+static const Count CHECK_NODES = 1024;
+
+// Size of cache line. Data of each thread starts at its own line, so
+// threads don't slow each other down by writing to the same line.
+static const int CACHE_LINE = 64;
+
+// History values are halved when one of them grows above this limit.
+static const int HISTORY_LIMIT = 1 << 28;
+
+// Constructor of SearchLimits.
+SearchLimits::SearchLimits() {
+    depth = 0;
+    nodes = 0;
+    milliseconds = 0;
+    soft_milliseconds = 0;
+    cancel = NULL;
+}
+
+// SearchListener
+// ==============
+SearchListener::~SearchListener() {
+}
+
+void SearchListener::iteration(const SearchInfo&) {
+}
+
+// Function print search info.
+void print_search_info(ostream& outs, const SearchInfo& info) {
+    outs << "depth " << info.depth << " score ";
+    if(is_mate_score(info.score)) {
+        int plies = MATE_SCORE - (info.score > 0 ? info.score : -info.score);
+        int moves = (plies + 1) / 2;
+        outs << "mate " << (info.score > 0 ? moves : -moves);
+    }
+    else {
+        outs << "cp " << info.score;
+    }
+    outs << " nodes " << info.nodes << " time " << info.seconds
+         << " nps " << info.nps << " pv";
+    for(int i=0; i<info.pv_length; i++)
+        outs << " " << info.pv[i].start() << info.pv[i].end();
+    outs << "\n";
+}
+
+// Functions score to table and score from table.
+// Mate scores are stored as distance from the position (not from root), as
+// the same position can be reached at different plies.
+static int score_to_table(int score, int ply) {
+    if(score > MATE_SCORE - MATE_WINDOW) return score + ply;
+    if(score < -MATE_SCORE + MATE_WINDOW) return score - ply;
+    return score;
+}
+
+static int score_from_table(int score, int ply) {
+    if(score > MATE_SCORE - MATE_WINDOW) return score - ply;
+    if(score < -MATE_SCORE + MATE_WINDOW) return score + ply;
+    return score;
+}
+
+// CLASS: SearchWorker
+// ===================
+// One search thread: its own board, PV table, killer and history tables.
+// Worker 0 runs in thread that called "think", reports iterations and
+// checks limits; others only help until "stop" is set.
+class alignas(CACHE_LINE) SearchWorker {
+public:
+    Search& search;
+    int id;
+    ChessBoard board;
+    atomic<Count> nodes;  // written only by this worker
+
+    Move pv_table[MAX_PLY][MAX_PLY];
+    int pv_length[MAX_PLY];
+
+    // Killers: two quiet moves per ply that caused beta cutoff.
+    // History: how much quiet move (by color, from, to) caused cutoffs.
+    Move killers[MAX_PLY][2];
+    int history[2][64][64];
+
+    SearchWorker(Search& _search, int _id);
+
+    void clear();
+    void new_search(const ChessBoard& position);
+    bool check_stop();
+    void update_pv(int ply, Move move);
+    void update_quiet(Move move, int depth, int ply);
+    bool probe_tablebase(int ply, int& score);
+    int quiescence(int alpha, int beta, int ply);
+    int negamax(int depth, int alpha, int beta, int ply);
+    int search_root(int depth, MoveList& moves);
+    void iterate(MoveList moves, int max_depth, SearchListener* listener);
+};
+
+// Constructor.
+SearchWorker::SearchWorker(Search& _search, int _id)
+    : search(_search), id(_id), board(NULL) {
+    nodes = 0;
+    clear();
+}
+
+// Method: clear
+// Forgets killers and history.
+void SearchWorker::clear() {
+    for(int ply=0; ply<MAX_PLY; ply++)
+        killers[ply][0] = killers[ply][1] = Move::null_move();
+    for(int color=0; color<2; color++)
+        for(int from=0; from<64; from++)
+            for(int to=0; to<64; to++)
+                history[color][from][to] = 0;
+}
+
+// Method: new search
+// Killers belong to positions of last search, so they are cleared. History
+// is kept, but made smaller, so new cutoffs count more.
+void SearchWorker::new_search(const ChessBoard& position) {
+    board = position;
+    board.set_event_sink(NULL);
+    nodes.store(0, memory_order_relaxed);
+
+    for(int ply=0; ply<MAX_PLY; ply++)
+        killers[ply][0] = killers[ply][1] = Move::null_move();
+    for(int color=0; color<2; color++)
+        for(int from=0; from<64; from++)
+            for(int to=0; to<64; to++)
+                history[color][from][to] /= 8;
+}
+
+// Method: check stop
+// Counts node and tells if search should stop. Only worker 0 checks limits;
+// it tells others to stop through "search.stop".
+bool SearchWorker::check_stop() {
+    Count count = nodes.load(memory_order_relaxed) + 1;
+
+    nodes.store(count, memory_order_relaxed);
+    if(id == 0 && count % CHECK_NODES == 0)
+        search.check_limits();
+    return search.stop.load(memory_order_relaxed);
+}
+
+// Method: update pv
+// Best line from "ply" is "move" followed by best line from "ply" + 1.
+void SearchWorker::update_pv(int ply, Move move) {
+    pv_table[ply][ply] = move;
+    for(int i=ply+1; i<pv_length[ply+1]; i++)
+        pv_table[ply][i] = pv_table[ply+1][i];
+    pv_length[ply] = pv_length[ply+1];
+}
+
+// Method: update quiet
+// Quiet move (one that doesn't take) caused beta cutoff: it becomes first
+// killer of this ply and its history grows with square of depth, so cutoffs
+// near root count more.
+void SearchWorker::update_quiet(Move move, int depth, int ply) {
+    int& value = history[board.get_turn()][move.from()][move.to()];
+
+    if(killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    value += depth * depth;
+    if(value > HISTORY_LIMIT) {
+        for(int color=0; color<2; color++)
+            for(int from=0; from<64; from++)
+                for(int to=0; to<64; to++)
+                    history[color][from][to] /= 2;
+    }
+}
+
+// Method: probe tablebase
+// Looks up position in tablebase. Mate from table is scored as mate found
+// by search, so shorter mates are still preferred.
+bool SearchWorker::probe_tablebase(int ply, int& score) {
+    const Tablebase* tablebase = search.tablebase;
+    TbResult result;
+
+    if(tablebase == NULL
+       || pop_count(board.get_position().get_occupied())
+          > tablebase->get_max_pieces())
+        return false;
+    if(!tablebase->probe(board.get_position(), board.get_turn(), result))
+        return false;
+
+    if(result.outcome == TB_OUTCOME_WIN)
+        score = MATE_SCORE - ply - result.plies;
+    else if(result.outcome == TB_OUTCOME_LOSS)
+        score = -MATE_SCORE + ply + result.plies;
+    else
+        score = 0;
+    return true;
+}
+
+// Method: quiescence
+// Searches captures only, until position is quiet, so that leaf is never
+// evaluated in the middle of exchange. Player on turn can also stop taking
+// ("stand pat"), so static evaluation is lower bound of score. Captures
+// that lose material (by SEE) are not searched. Player in chess can't stand
+// pat and must escape with any move.
+int SearchWorker::quiescence(int alpha, int beta, int ply) {
+    Color turn = board.get_turn();
+    Move move;
+    int best;
+
+    pv_length[ply] = ply;
+    if(check_stop()) return 0;
+    if(probe_tablebase(ply, best)) return best;
+    if(ply >= MAX_PLY - 1) return evaluate(board.get_eval(), turn);
+
+    if(board.is_in_chess(turn)) return negamax(1, alpha, beta, ply);
+
+    best = evaluate(board.get_eval(), turn);
+    if(best >= beta) return best;
+    if(best > alpha) alpha = best;
+
+    MovePicker picker(board.get_position(), turn);
+
+    while(!(move = picker.next()).is_null()) {
+        MoveUndo undo;
+        int score;
+
+        board.make_move(move.start(), move.end(), undo);
+        if(board.is_in_chess(turn)) {
+            board.unmake_move(move.start(), move.end(), undo);
+            continue;
+        }
+
+        board.pass_turn();
+        score = -quiescence(-beta, -alpha, ply+1);
+        board.pass_turn();
+        board.unmake_move(move.start(), move.end(), undo);
+
+        if(search.stop.load(memory_order_relaxed)) return 0;
+
+        if(score > best) {
+            best = score;
+            if(score > alpha) {
+                alpha = score;
+                update_pv(ply, move);
+                if(alpha >= beta) break;
+            }
+        }
+    }
+    return best;
+}
+
+// Method: negamax
+// Returns score of position from the point of view of player on turn. If
+// true score is outside (alpha, beta), returned score is only bound: moves
+// that can't change result at lower ply are not searched (beta cutoff).
+// Mate scores depend on "ply", so shorter mates are preferred.
+int SearchWorker::negamax(int depth, int alpha, int beta, int ply) {
+    TTEntry entry;
+    Move hash_move = Move::null_move(), best_move = Move::null_move();
+    Move move;
+    Key key = board.get_key();
+    Color turn = board.get_turn();
+    int alpha_start = alpha;
+    int best = -INFINITE_SCORE;
+    int legal = 0;
+
+    if(depth == 0) return quiescence(alpha, beta, ply);
+
+    pv_length[ply] = ply;
+    if(check_stop()) return 0;
+    if(ply >= MAX_PLY - 1) return evaluate(board.get_eval(), turn);
+
+    // Position that already occurred (in game or in this line of search)
+    // can be repeated by either player, so it is scored as draw.
+    if(board.is_repetition(1)) return 0;
+
+    // Fifty-move draw can be claimed only if player on turn isn't mated.
+    if(board.get_halfmove_clock() >= FIFTY_MOVE_PLIES) {
+        MoveList moves;
+
+        board.legal_moves(moves);
+        if(moves.size() == 0 && board.is_in_chess(turn))
+            return -MATE_SCORE + ply;
+        return 0;
+    }
+    if(probe_tablebase(ply, best)) return best;
+
+    if(search.table.probe(key, entry)) {
+        hash_move = entry.move;
+        if(entry.depth >= depth) {
+            int score = score_from_table(entry.score, ply);
+
+            if(entry.bound == BOUND_EXACT
+               || (entry.bound == BOUND_LOWER && score >= beta)
+               || (entry.bound == BOUND_UPPER && score <= alpha))
+                return score;
+        }
+    }
+
+    MovePicker picker(board.get_position(), turn, hash_move, killers[ply],
+                      history[turn]);
+
+    while(!(move = picker.next()).is_null()) {
+        bool quiet = board.get_position().is_empty(move.to());
+        MoveUndo undo;
+        int score;
+
+        // Moves are pseudo-legal: move that leaves own king in chess is
+        // taken back and skipped.
+        board.make_move(move.start(), move.end(), undo);
+        if(board.is_in_chess(turn)) {
+            board.unmake_move(move.start(), move.end(), undo);
+            continue;
+        }
+        legal++;
+
+        board.pass_turn();
+        score = -negamax(depth-1, -beta, -alpha, ply+1);
+        board.pass_turn();
+        board.unmake_move(move.start(), move.end(), undo);
+
+        if(search.stop.load(memory_order_relaxed)) return 0;
+
+        if(score > best) {
+            best = score;
+            best_move = move;
+            if(score > alpha) {
+                alpha = score;
+                update_pv(ply, move);
+                if(alpha >= beta) {
+                    if(quiet) update_quiet(move, depth, ply);
+                    break;
+                }
+            }
+        }
+    }
+
+    if(legal == 0)
+        return board.is_in_chess(turn) ? -MATE_SCORE + ply : 0;
+
+    Bound bound = best >= beta ? BOUND_LOWER
+                : best > alpha_start ? BOUND_EXACT : BOUND_UPPER;
+    search.table.store(key, best_move, score_to_table(best, ply), depth,
+                       bound);
+    return best;
+}
+
+// Method: search root
+// Same as negamax at ply 0, but over given list of moves, which is reordered
+// so that best move is searched first in next iteration.
+int SearchWorker::search_root(int depth, MoveList& moves) {
+    int alpha = -INFINITE_SCORE;
+    int best_index = 0;
+
+    pv_length[0] = 0;
+    check_stop();
+
+    for(int i=0; i<moves.size(); i++) {
+        MoveUndo undo;
+        int score;
+
+        board.make_move(moves[i].start(), moves[i].end(), undo);
+        board.pass_turn();
+        score = -negamax(depth-1, -INFINITE_SCORE, -alpha, 1);
+        board.pass_turn();
+        board.unmake_move(moves[i].start(), moves[i].end(), undo);
+
+        if(search.stop.load(memory_order_relaxed)) return 0;
+
+        if(score > alpha) {
+            alpha = score;
+            best_index = i;
+            update_pv(0, moves[i]);
+        }
+    }
+
+    // Move best move to the front, keeping order of the rest.
+    MoveList ordered;
+    ordered.add(moves[best_index]);
+    for(int i=0; i<moves.size(); i++) {
+        if(i != best_index) ordered.add(moves[i]);
+    }
+    moves = ordered;
+
+    search.table.store(board.get_key(), moves[0], score_to_table(alpha, 0),
+                       depth, BOUND_EXACT);
+    return alpha;
+}
+
+// Method: iterate
+// Iterative deepening of one worker. Helpers with odd id search one ply
+// deeper than main worker.
+void SearchWorker::iterate(MoveList moves, int max_depth,
+                           SearchListener* listener) {
+    for(int depth=1; depth<=max_depth; depth++) {
+        int search_depth = depth;
+
+        if(id % 2 == 1 && depth < max_depth) search_depth++;
+
+        int score = search_root(search_depth, moves);
+        if(search.stop.load(memory_order_relaxed)) break;
+        if(id != 0) continue;
+
+        search.report(depth, score, pv_table[0], pv_length[0], listener);
+
+        // Mate that was found can't be improved by deeper search.
+        if(is_mate_score(score) && MATE_SCORE - abs(score) <= depth) break;
+        if(search.check_limits() || search.soft_limit_reached()) break;
+    }
+}
+
+// Constructor.
+Search::Search(int threads, int hash_mb) : table(hash_mb) {
+    tablebase = NULL;
+    stop = false;
+    info.depth = 0;
+    info.pv_length = 0;
+    overshoot = 0;
+    set_threads(threads);
+}
+
+// Destructor.
+Search::~Search() {
+    for(size_t i=0; i<workers.size(); i++)
+        delete workers[i];
+}
+
+// PUBLIC METHOD: set threads
+// ==========================
+void Search::set_threads(int threads) {
+    if(threads < 1) threads = 1;
+
+    for(size_t i=0; i<workers.size(); i++)
+        delete workers[i];
+    workers.clear();
+    for(int i=0; i<threads; i++)
+        workers.push_back(new SearchWorker(*this, i));
+}
+
+// PUBLIC METHOD: set hash
+// =======================
+void Search::set_hash(int hash_mb) {
+    table.resize(hash_mb);
+}
+
+// PUBLIC METHOD: clear
+// ====================
+void Search::clear() {
+    table.clear();
+    for(size_t i=0; i<workers.size(); i++)
+        workers[i]->clear();
+}
+
+// PUBLIC METHOD: set tablebase
+// ============================
+void Search::set_tablebase(const Tablebase* _tablebase) {
+    tablebase = _tablebase;
+}
+
+// Method: elapsed
+// Seconds since search started.
+double Search::elapsed() const {
+    return chrono::duration<double>(chrono::steady_clock::now()
+                                    - start_time).count();
+}
+
+// Method: total nodes
+Count Search::total_nodes() const {
+    Count total = 0;
+
+    for(size_t i=0; i<workers.size(); i++)
+        total += workers[i]->nodes.load(memory_order_relaxed);
+    return total;
+}
+
+// Method: check limits
+// Sets "stop" if node or hard time limit is reached or search was
+// cancelled. It is called by worker 0 every CHECK_NODES nodes and after
+// every iteration. Limits are ignored until first depth is finished, so
+// there is always move to return.
+bool Search::check_limits() {
+    if(info.depth == 0) return false;
+
+    if(limits.cancel != NULL && limits.cancel->load(memory_order_relaxed))
+        stop = true;
+    if(limits.nodes > 0 && total_nodes() >= limits.nodes)
+        stop = true;
+    if(limits.milliseconds > 0 && elapsed() * 1000 >= limits.milliseconds)
+        stop = true;
+    return stop;
+}
+
+// Method: soft limit reached
+// Tells if there is not enough time left for next depth.
+bool Search::soft_limit_reached() const {
+    return limits.soft_milliseconds > 0
+           && elapsed() * 1000 >= limits.soft_milliseconds / 2.0;
+}
+
+// Method: report
+// Keeps result of finished iteration of worker 0 and reports it.
+void Search::report(int depth, int score, const Move pv[], int pv_length,
+                    SearchListener* listener) {
+    info.depth = depth;
+    info.score = score;
+    info.nodes = total_nodes();
+    info.seconds = elapsed();
+    info.nps = info.seconds > 0 ? static_cast<Count>(info.nodes / info.seconds)
+                                : 0;
+    info.pv_length = pv_length;
+    for(int i=0; i<pv_length; i++)
+        info.pv[i] = pv[i];
+
+    if(listener != NULL) listener->iteration(info);
+}
+
+// PUBLIC METHOD: think
+// ====================
+// Iterative deepening: results of depth d are used to order moves at depth
+// d+1, and if limit is reached in the middle of depth, result of last
+// finished depth is returned. Helpers run until worker 0 finishes.
+Move Search::think(const ChessBoard& position, const SearchLimits& _limits,
+                   SearchListener* listener) {
+    MoveList moves;
+    vector<thread> helpers;
+    int max_depth = _limits.depth > 0 ? _limits.depth : MAX_PLY - 1;
+
+    limits = _limits;
+    stop = false;
+    overshoot = 0;
+    start_time = chrono::steady_clock::now();
+    info.depth = 0;
+    info.score = 0;
+    info.nodes = 0;
+    info.seconds = 0;
+    info.nps = 0;
+    info.pv_length = 0;
+
+    ChessBoard board = position;
+    board.legal_moves(moves);
+    if(moves.size() == 0) return Move::null_move();
+    if(max_depth > MAX_PLY - 1) max_depth = MAX_PLY - 1;
+
+    table.new_search();
+    for(size_t i=0; i<workers.size(); i++)
+        workers[i]->new_search(position);
+
+    SearchListener* no_listener = NULL;
+    for(size_t i=1; i<workers.size(); i++) {
+        helpers.push_back(thread(&SearchWorker::iterate, workers[i], moves,
+                                 MAX_PLY - 1, no_listener));
+    }
+
+    workers[0]->iterate(moves, max_depth, listener);
+
+    stop = true;
+    for(size_t i=0; i<helpers.size(); i++)
+        helpers[i].join();
+
+    if(limits.milliseconds > 0)
+        overshoot = elapsed() * 1000 - limits.milliseconds;
+    return info.pv[0];
+}
+
+// PUBLIC METHOD: get info
+// =======================
+const SearchInfo& Search::get_info() const {
+    return info;
+}
+
+// PUBLIC METHOD: get overshoot
+// ============================
+double Search::get_overshoot() const {
+    return overshoot;
+}
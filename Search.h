@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Search.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for class Search, which chooses move for player
+//              on turn. It uses negamax search with alpha-beta pruning and
+//              iterative deepening: position is searched to depth 1, 2, 3,
+//              ... until limit (depth, nodes or time) is reached. After every
+//              finished depth best line of play (principal variation, PV) is
+//              reported to SearchListener.
+//
+//              Search can use more threads ("lazy SMP"): all threads search
+//              the same position and share only transposition table (refer
+//              to TranspositionTable.h). Results one thread stores cut off
+//              work of others, so together they reach given depth sooner.
+//              Helper threads search every other iteration one ply deeper,
+//              so they don't all search the same tree in the same order.
+//              Each thread keeps its own killer and history tables
+//              (moves that caused cutoffs before), which are used to order
+//              moves (refer to MovePicker.h).
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include <chrono>
+#include <atomic>
+#include <vector>
+
+#include "ChessBoard.hpp"
+#include "TranspositionTable.h"
+#include "Tablebase.h"
+
+using namespace std;
+
+
+// TYPEDEFs
+// ========
+typedef unsigned long long Count;
+
+// Maximum depth of search (in plies).
+const int MAX_PLY = 64;
+
+// Scores. Mate in N plies is MATE_SCORE - N, mated in N plies is
+// -MATE_SCORE + N. INFINITE_SCORE is bigger than any real score.
+// Search finds mates at most MAX_PLY plies from root and tablebase adds
+// its distance to mate, so mate scores lie within MATE_WINDOW of
+// MATE_SCORE.
+const int MATE_SCORE = 30000;
+const int INFINITE_SCORE = 32000;
+const int MATE_WINDOW = MAX_PLY + TB_MAX_PLIES;
+
+// Function that tells if "score" means that one side mates the other.
+inline bool is_mate_score(int score) {
+    return score > MATE_SCORE - MATE_WINDOW
+           || score < -MATE_SCORE + MATE_WINDOW;
+}
+
+// STRUCT: SearchLimits
+// ====================
+// When search stops. 0 means no limit. Search always finishes at least
+// depth 1, so it returns legal move even with smallest limits.
+//    - milliseconds: hard limit. Search stops in the middle of depth and
+//      returns result of last finished depth.
+//    - soft_milliseconds: time search should use. New depth is not started
+//      after half of it is used, as next depth usually takes longer than all
+//      previous ones together.
+//    - cancel: flag owned by caller. When any thread sets it, search stops
+//      as with hard limit. NULL means no flag.
+// Nodes, hard limit and cancel flag are checked every CHECK_NODES nodes
+// (refer to Search.cpp), which is well below one millisecond.
+struct SearchLimits {
+    int depth;
+    Count nodes;
+    int milliseconds;
+    int soft_milliseconds;
+    const atomic<bool>* cancel;
+
+    SearchLimits();
+};
+
+// STRUCT: SearchInfo
+// ==================
+// Result of one finished iteration: depth, score (from the point of view of
+// player on turn), nodes (of all threads) and time of whole search so far,
+// and PV.
+struct SearchInfo {
+    int depth;
+    int score;
+    Count nodes;
+    double seconds;
+    Count nps;  // nodes per second
+    Move pv[MAX_PLY];
+    int pv_length;
+};
+
+// CLASS: SearchListener
+// =====================
+// Interface for receiving progress of search. Default method is empty.
+//    - iteration: depth was finished.
+class SearchListener {
+public:
+    virtual ~SearchListener();
+
+    virtual void iteration(const SearchInfo& info);
+};
+
+// Function print search info.
+// Prints info in one line: depth, score, nodes, time, nps and PV. Mate
+// scores are printed as "mate N" (N moves, negative if player is mated).
+void print_search_info(ostream& outs, const SearchInfo& info);
+
+// Default size of transposition table in MB.
+const int DEFAULT_HASH_MB = 16;
+
+// Search thread. It is defined in Search.cpp.
+class SearchWorker;
+
+// CLASS: Search
+// =============
+// Usage:
+//     Search search(4);   <- search with 4 threads
+//     SearchLimits limits;
+//     limits.depth = 6;
+//     Move best = search.think(board, limits, &listener);
+// Search works on its own copies of board, so "board" is not changed.
+// Transposition table and history are kept between calls of "think"; they
+// should be cleared with "clear" when new game starts.
+class Search {
+private:
+    friend class SearchWorker;
+
+    TranspositionTable table;
+    const Tablebase* tablebase;  // NULL if there are no tables
+    vector<SearchWorker*> workers;  // workers[0] runs in calling thread
+    SearchLimits limits;
+    atomic<bool> stop;
+    chrono::steady_clock::time_point start_time;
+    SearchInfo info;  // last finished iteration of main thread
+    double overshoot;  // refer to "get_overshoot"
+
+    double elapsed() const;
+    Count total_nodes() const;
+    bool check_limits();
+    bool soft_limit_reached() const;
+    void report(int depth, int score, const Move pv[], int pv_length,
+                SearchListener* listener);
+
+public:
+    Search(int threads = 1, int hash_mb = DEFAULT_HASH_MB);
+    ~Search();
+
+    Search(const Search&) = delete;
+    Search& operator=(const Search&) = delete;
+
+    // PUBLIC METHODS: set threads / set hash / clear
+    // ==============================================
+    // Change number of threads and size of transposition table, and clear
+    // all that was learned in previous searches.
+    void set_threads(int threads);
+    void set_hash(int hash_mb);
+    void clear();
+
+    // PUBLIC METHOD: set tablebase
+    // ============================
+    // Positions found in "tablebase" are not searched: their exact result
+    // (mate in N plies or draw) is used as score. Tablebase doesn't know
+    // history of game, so fifty-move rule is not considered there. NULL
+    // turns probing off. Search doesn't own the tablebase.
+    void set_tablebase(const Tablebase* _tablebase);
+
+    // PUBLIC METHOD: think
+    // ====================
+    // Searches position of "position" within "limits" and returns best move
+    // of player on turn. Returns "no move" if player has no legal move.
+    // Every finished depth is reported to "listener", which can be NULL.
+    Move think(const ChessBoard& position, const SearchLimits& _limits,
+               SearchListener* listener = NULL);
+
+    // PUBLIC METHOD: get info
+    // =======================
+    // Returns info of last finished iteration of last "think".
+    const SearchInfo& get_info() const;
+
+    // PUBLIC METHOD: get overshoot
+    // ============================
+    // Returns how many milliseconds last "think" took longer than its hard
+    // time limit (negative if it returned before the limit). It includes
+    // time to stop all threads. Without hard limit it returns 0.
+    double get_overshoot() const;
+};
+
+
+#endif // SEARCH_H_
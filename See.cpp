@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: See.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to See.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "See.h"
+#include "Attacks.h"
+#include "Evaluation.h"
+
+// Longest possible exchange: every piece of both players takes once.
+static const int MAX_EXCHANGE = 32;
+
+// King can't be taken, so in exchange it is worth more than everything
+// else together: king takes last, and only if square is not defended.
+static const int SEE_KING_VALUE = 20000;
+
+// Function see value.
+static int see_value(PieceType type) {
+    return type == KING ? SEE_KING_VALUE : PIECE_VALUES[type];
+}
+
+// Function least valuable.
+// Finds least valuable piece of Color "color" among "attackers". Returns
+// its square or -1 if there is none.
+static int least_valuable(const Position& position, Bitboard attackers,
+                          Color color, PieceType& type) {
+    for(int t=PAWN; t<=KING; t++) {
+        Bitboard pieces = attackers & position.get_pieces(
+                                          color, static_cast<PieceType>(t));
+        if(pieces) {
+            type = static_cast<PieceType>(t);
+            return first_index(pieces);
+        }
+    }
+    return -1;
+}
+
+// Function see.
+// "gain[d]" is material won after "d" captures, if opponent doesn't take
+// back. Going back from the end, each player chooses between taking and
+// stopping, whichever is better for him.
+int see(const Position& position, Move move) {
+    int gain[MAX_EXCHANGE];
+    int from = move.from();
+    int to = move.to();
+    int depth = 0;
+    Color color = position.color_at(from);
+    PieceType type = position.type_at(from);
+    Bitboard occupied = position.get_occupied();
+    Bitboard diagonal = position.get_pieces(WHITE, BISHOP)
+                        | position.get_pieces(BLACK, BISHOP)
+                        | position.get_pieces(WHITE, QUEEN)
+                        | position.get_pieces(BLACK, QUEEN);
+    Bitboard straight = position.get_pieces(WHITE, ROOK)
+                        | position.get_pieces(BLACK, ROOK)
+                        | position.get_pieces(WHITE, QUEEN)
+                        | position.get_pieces(BLACK, QUEEN);
+    Bitboard attackers = attackers_to(position, to, occupied);
+
+    gain[0] = position.is_empty(to) ? 0 : see_value(position.type_at(to));
+
+    while(true) {
+        depth++;
+        gain[depth] = see_value(type) - gain[depth-1];
+
+        // Neither taking nor stopping can make it better for this player.
+        if((-gain[depth-1] > gain[depth] ? -gain[depth-1] : gain[depth]) < 0)
+            break;
+
+        // Piece that took leaves its square; pieces behind it join.
+        occupied ^= index_bit(from);
+        attackers |= (bishop_attacks(to, occupied) & diagonal)
+                     | (rook_attacks(to, occupied) & straight);
+        attackers &= occupied;
+
+        color = inverse_color(color);
+        from = least_valuable(position, attackers, color, type);
+        if(from < 0 || depth + 1 >= MAX_EXCHANGE) break;
+    }
+
+    while(--depth) {
+        int take = -gain[depth];
+        if(take < gain[depth-1]) gain[depth-1] = take;
+    }
+    return gain[0];
+}
@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: See.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for static exchange evaluation (SEE). SEE tells
+//              how much material player wins or loses with capture, if both
+//              players keep taking on the same square, always with their
+//              least valuable piece, and each can stop when taking further
+//              would lose material.
+//
+//              Moves are not made on the board: attackers of the square are
+//              found with attack tables (refer to Attacks.h), and pieces that
+//              took are removed from occupancy bitboard, so sliding pieces
+//              behind them (x-rays) join the exchange.
+//              Pins and checks are not considered.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SEE_H_
+#define SEE_H_
+
+#include "Position.h"
+#include "Move.h"
+
+
+// Function see returns material (in centipawns, refer to Evaluation.h) that
+// player who makes Move "move" wins with exchange on its ending square.
+// Move to empty square is valued too: its result is 0 or loss of the moved
+// piece.
+int see(const Position& position, Move move);
+
+
+#endif // SEE_H_
@@ -64,7 +64,7 @@ ostream& operator<<(ostream& outs, Square square) {
 }
 
 // Function that converts string to square.
-bool string_to_square(string square_str, Square& square) {
+bool string_to_square(string_view square_str, Square& square) {
     if(square_str.length() != 2) return false;
     if(square_str[0] < 'A' || 'H' < square_str[0]) return false;
     if(square_str[1] < '1' || '8' < square_str[1]) return false;
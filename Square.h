@@ -12,6 +12,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 using namespace std;
 
@@ -52,7 +53,9 @@ public:
 // Input string is "square_str". Expected input is in format [A-H][0-7].
 // If converted result gets writen in Square "square". Function returns true
 // if conversion is successful and false if not.
-bool string_to_square(string square_str, Square& square);
+// String is taken as string_view, so both "string" and characters read
+// straight from file (or C string) are converted without any copy.
+bool string_to_square(string_view square_str, Square& square);
 
 
 #endif // SQUARE_H_
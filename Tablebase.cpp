@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Tablebase.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Tablebase.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <dirent.h>
+
+#include "Tablebase.h"
+
+// Order of pieces in signature and index. King is always first and there
+// is exactly one of each color.
+static const PieceType SIGNATURE_ORDER[6] = {
+    KING, QUEEN, ROOK, BISHOP, KNIGHT, PAWN
+};
+
+// Material code: for every color number of queens, rooks, bishops, knights
+// and pawns, 3 bits each; black pieces are above white ones.
+static const int CODE_BITS = 3;
+static const int COLOR_CODE_BITS = 5 * CODE_BITS;
+
+// Function material code.
+static unsigned material_code(const Position& position) {
+    unsigned code = 0;
+
+    for(int color=WHITE; color<=BLACK; color++) {
+        for(int i=1; i<6; i++) {
+            int count = pop_count(position.get_pieces(
+                                      static_cast<Color>(color),
+                                      SIGNATURE_ORDER[i]));
+            code |= count << (color * COLOR_CODE_BITS + (i-1) * CODE_BITS);
+        }
+    }
+    return code;
+}
+
+// Function mirror code.
+// Code of the same material with colors swapped.
+static unsigned mirror_code(unsigned code) {
+    unsigned mask = (1u << COLOR_CODE_BITS) - 1;
+    return ((code & mask) << COLOR_CODE_BITS) | (code >> COLOR_CODE_BITS);
+}
+
+// Function signature code.
+// Reads signature like "KRvKN" and computes its material code and number
+// of pieces. Returns false if "signature" isn't valid signature.
+static bool signature_code(string_view signature, unsigned& code,
+                           int& pieces) {
+    size_t i = 0;
+
+    code = 0;
+    pieces = 0;
+    for(int color=WHITE; color<=BLACK; color++) {
+        int last = 0;
+
+        if(color == BLACK) {
+            if(i >= signature.size() || signature[i] != 'v') return false;
+            i++;
+        }
+        if(i >= signature.size() || signature[i] != 'K') return false;
+        i++;
+        pieces++;
+
+        while(i < signature.size() && signature[i] != 'v') {
+            int type = 1;
+
+            while(type < 6 && PIECE_SYMBOLS[SIGNATURE_ORDER[type]]
+                              != signature[i])
+                type++;
+            if(type == 6 || type < last) return false;
+
+            int shift = color * COLOR_CODE_BITS + (type-1) * CODE_BITS;
+            unsigned count = ((code >> shift) & 7) + 1;
+            if(count > 7) return false;
+            code += 1u << shift;
+            last = type;
+            pieces++;
+            i++;
+        }
+    }
+    return i == signature.size() && pieces <= TB_MAX_PIECES;
+}
+
+// Function tb encode.
+unsigned char tb_encode(const TbResult& result) {
+    if(result.outcome == TB_OUTCOME_WIN) return TB_WIN + result.plies;
+    if(result.outcome == TB_OUTCOME_LOSS) return TB_LOSS + result.plies;
+    return TB_DRAW;
+}
+
+// Function tb decode.
+bool tb_decode(unsigned char value, TbResult& result) {
+    if(value == TB_INVALID) return false;
+
+    if(value == TB_DRAW) {
+        result.outcome = TB_OUTCOME_DRAW;
+        result.plies = 0;
+    }
+    else if(value >= TB_LOSS) {
+        result.outcome = TB_OUTCOME_LOSS;
+        result.plies = value - TB_LOSS;
+    }
+    else {
+        result.outcome = TB_OUTCOME_WIN;
+        result.plies = value - TB_WIN;
+    }
+    return true;
+}
+
+// Function material signature.
+string material_signature(const Position& position) {
+    string signature;
+
+    for(int color=WHITE; color<=BLACK; color++) {
+        if(color == BLACK) signature += 'v';
+        for(int i=0; i<6; i++) {
+            int count = pop_count(position.get_pieces(
+                                      static_cast<Color>(color),
+                                      SIGNATURE_ORDER[i]));
+            signature.append(count, PIECE_SYMBOLS[SIGNATURE_ORDER[i]]);
+        }
+    }
+    return signature;
+}
+
+// Function table index.
+// Squares of pieces of the same type are sorted, so every position has
+// only one index. With "mirror", square y is moved to 7 - y (index ^ 56),
+// which changes their order, so they are sorted after flipping.
+unsigned long long table_index(const Position& position, Color turn,
+                               bool mirror) {
+    unsigned long long index = (mirror ? inverse_color(turn) : turn);
+    int flip = (mirror ? 56 : 0);
+
+    for(int color=WHITE; color<=BLACK; color++) {
+        Color real = static_cast<Color>(mirror ? 1 - color : color);
+
+        for(int i=0; i<6; i++) {
+            Bitboard pieces = position.get_pieces(real, SIGNATURE_ORDER[i]);
+            int squares[TB_MAX_PIECES];
+            int count = 0;
+
+            while(pieces && count < TB_MAX_PIECES) {
+                int square = pop_first_index(pieces) ^ flip;
+                int j = count++;
+
+                while(j > 0 && squares[j-1] > square) {
+                    squares[j] = squares[j-1];
+                    j--;
+                }
+                squares[j] = square;
+            }
+            for(int j=0; j<count; j++)
+                index = index * 64 + squares[j];
+        }
+    }
+    return index;
+}
+
+// Method: load
+// Maps file and checks its header. If anything is wrong, "values" stays
+// NULL and table is never found.
+void Tablebase::Table::load() {
+    const unsigned char* data;
+    unsigned long long expected = 2;
+    unsigned long long count = 0;
+    unsigned file_pieces = 0;
+
+    if(!file.open(path.c_str())) return;
+    if(file.get_size() < static_cast<size_t>(TB_HEADER_SIZE)) return;
+
+    data = reinterpret_cast<const unsigned char*>(file.get_data());
+    if(memcmp(data, TB_MAGIC, 4) != 0) return;
+    for(int i=0; i<4; i++)
+        file_pieces |= static_cast<unsigned>(data[4 + i]) << (8 * i);
+    for(int i=0; i<8; i++)
+        count |= static_cast<unsigned long long>(data[8 + i]) << (8 * i);
+    for(int i=0; i<pieces; i++)
+        expected *= 64;
+
+    if(file_pieces != static_cast<unsigned>(pieces) || count != expected
+       || file.get_size() != TB_HEADER_SIZE + count)
+        return;
+
+    size = count;
+    values = data + TB_HEADER_SIZE;
+}
+
+// Constructor.
+Tablebase::Tablebase() {
+    max_pieces = 0;
+}
+
+// Destructor.
+Tablebase::~Tablebase() {
+    close();
+}
+
+// PUBLIC METHOD: open
+// ===================
+int Tablebase::open(const char* directory) {
+    DIR* dir;
+    struct dirent* entry;
+    size_t extension = strlen(TB_EXTENSION);
+
+    close();
+    dir = opendir(directory);
+    if(dir == NULL) return 0;
+
+    while((entry = readdir(dir)) != NULL) {
+        string_view name(entry->d_name);
+        unsigned code;
+        int pieces;
+
+        if(name.size() <= extension
+           || name.substr(name.size() - extension) != TB_EXTENSION)
+            continue;
+        if(!signature_code(name.substr(0, name.size() - extension), code,
+                           pieces))
+            continue;
+        if(find(code) != NULL) continue;
+
+        Table* table = new Table();
+        table->code = code;
+        table->pieces = pieces;
+        table->path = string(directory) + "/" + string(name);
+        table->values = NULL;
+        table->size = 0;
+        tables.push_back(table);
+        if(pieces > max_pieces) max_pieces = pieces;
+    }
+    closedir(dir);
+    return static_cast<int>(tables.size());
+}
+
+// PUBLIC METHOD: close
+// ====================
+void Tablebase::close() {
+    for(size_t i=0; i<tables.size(); i++)
+        delete tables[i];
+    tables.clear();
+    max_pieces = 0;
+}
+
+// PUBLIC METHOD: get max pieces
+// =============================
+int Tablebase::get_max_pieces() const {
+    return max_pieces;
+}
+
+// Method: find
+// There are only few tables, so they are searched one by one.
+Tablebase::Table* Tablebase::find(unsigned code) const {
+    for(size_t i=0; i<tables.size(); i++) {
+        if(tables[i]->code == code) return tables[i];
+    }
+    return NULL;
+}
+
+// PUBLIC METHOD: probe
+// ====================
+bool Tablebase::probe(const Position& position, Color turn,
+                      TbResult& result) const {
+    int pieces = pop_count(position.get_occupied());
+    unsigned code;
+    bool mirror = false;
+    Table* table;
+
+    if(pieces == 2) {
+        result.outcome = TB_OUTCOME_DRAW;
+        result.plies = 0;
+        return true;
+    }
+    if(pieces > max_pieces) return false;
+
+    code = material_code(position);
+    table = find(code);
+    if(table == NULL) {
+        table = find(mirror_code(code));
+        mirror = true;
+    }
+    if(table == NULL) return false;
+
+    call_once(table->loaded, &Table::load, table);
+    if(table->values == NULL) return false;
+
+    unsigned long long index = table_index(position, turn, mirror);
+    if(index >= table->size) return false;
+    return tb_decode(table->values[index], result);
+}
+
+// PUBLIC METHOD: has table
+// ========================
+bool Tablebase::has_table(const Position& position) const {
+    unsigned code = material_code(position);
+
+    if(pop_count(position.get_occupied()) == 2) return true;
+    return find(code) != NULL || find(mirror_code(code)) != NULL;
+}
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Tablebase.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for endgame tablebases. Tablebase holds exact
+//              result of every position with given material (for example
+//              king and queen against king): whether player on turn wins,
+//              loses or draws, and in how many plies mate comes (distance
+//              to mate, DTM). Tables are generated by chess-tbgen (refer to
+//              TablebaseGen.cpp) for rules of this engine, which has no
+//              castling, en passant or promotion; that is also why
+//              standard tables (Syzygy, Nalimov) can't be used.
+//
+//              Every table is one file in tablebase directory, named by
+//              material, for example "KQvK.ctb" (white pieces, "v", black
+//              pieces). Position with colors swapped is found in the same
+//              table mirrored, so "KvKQ" needs no file of its own.
+//              File layout (little endian):
+//                  magic "CTB1", number of pieces (4 bytes),
+//                  number of values (8 bytes),
+//                  one byte for every index (refer to "table_index").
+//              Files are found when directory is opened, but each is mapped
+//              (refer to MappedFile.h) only when it is probed the first
+//              time. Tables are only read, so one Tablebase can be probed
+//              by all search threads at once.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TABLEBASE_H_
+#define TABLEBASE_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+
+#include "Position.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+
+// Biggest number of pieces (kings included) of one table. Table has
+// 2 * 64^pieces values, so with 4 pieces it takes 32 MB.
+const int TB_MAX_PIECES = 4;
+
+// File format.
+const char TB_MAGIC[4] = {'C', 'T', 'B', '1'};
+const int TB_HEADER_SIZE = 16;
+const char TB_EXTENSION[] = ".ctb";
+
+// Values stored in table. Draw and invalid index (pieces on the same
+// square, player who is not on turn in chess, ...) have their own values;
+// TB_WIN + N means that player on turn mates in N plies and TB_LOSS + N
+// that he is mated in N plies (0: he is checkmated).
+const unsigned char TB_INVALID = 0;
+const unsigned char TB_WIN = 0;     // + 1 ... 127
+const unsigned char TB_LOSS = 128;  // + 0 ... 126
+const unsigned char TB_DRAW = 255;
+
+// Longest distance to mate that can be stored in table.
+const int TB_MAX_PLIES = 127;
+
+// Enumerator: TbOutcome is result for player on turn.
+enum TbOutcome {
+    TB_OUTCOME_LOSS,
+    TB_OUTCOME_DRAW,
+    TB_OUTCOME_WIN
+};
+
+// STRUCT: TbResult
+// ================
+// Result of probe. "plies" is distance to mate (0 for draw).
+struct TbResult {
+    TbOutcome outcome;
+    int plies;
+};
+
+// Functions that convert between TbResult and value stored in table.
+// "tb_decode" returns false for TB_INVALID.
+unsigned char tb_encode(const TbResult& result);
+bool tb_decode(unsigned char value, TbResult& result);
+
+// Function material signature returns name of table of "position", for
+// example "KRvKN". Pieces of each color are in order K, Q, R, B, N, P.
+string material_signature(const Position& position);
+
+// Function table index returns index of "position" with player "turn" on
+// turn in its table: turn and squares of all pieces, in order of
+// signature (pieces of the same type by square), as number with base 64.
+// If "mirror" is true, index is computed for position with colors swapped
+// and board flipped (rows 1-8 exchanged), which is found in the mirrored
+// table.
+unsigned long long table_index(const Position& position, Color turn,
+                               bool mirror);
+
+// CLASS: Tablebase
+// ================
+// Usage:
+//     Tablebase tablebase;
+//     tablebase.open("tables");
+//     TbResult result;
+//     if(tablebase.probe(board.get_position(), board.get_turn(), result))
+//         ...
+// "open" and "close" must not be called while other threads probe.
+class Tablebase {
+private:
+    // STRUCT: Table
+    // =============
+    // One file. "code" identifies its material (refer to Tablebase.cpp).
+    // File is mapped by "load", once, by first thread that probes it.
+    struct Table {
+        unsigned code;
+        int pieces;
+        string path;
+        once_flag loaded;
+        MappedFile file;
+        const unsigned char* values;
+        unsigned long long size;
+
+        void load();
+    };
+
+    vector<Table*> tables;
+    int max_pieces;
+
+    Table* find(unsigned code) const;
+
+public:
+    Tablebase();
+    ~Tablebase();
+
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+
+    // Method open finds all tables in "directory" (tables found before are
+    // forgotten). Returns number of tables found.
+    int open(const char* directory);
+    void close();
+
+    // Most pieces of any table found (0 if there are none). Positions with
+    // more pieces are never found, so caller can skip probe.
+    int get_max_pieces() const;
+
+    // Method probe looks up "position" with player "turn" on turn. Returns
+    // false if there is no table for it (or table file is broken).
+    // Position with kings only is always draw and needs no table.
+    bool probe(const Position& position, Color turn, TbResult& result) const;
+
+    // Method has table tells if there is table for material of "position"
+    // (placement of pieces doesn't matter). Kings alone need no table.
+    bool has_table(const Position& position) const;
+};
+
+
+#endif // TABLEBASE_H_
@@ -0,0 +1,467 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: TablebaseGen.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Tablebase generator. It computes tables of endgames for
+//              rules of this engine (refer to Tablebase.h) and writes them
+//              in given directory.
+//
+//              Usage: chess-tbgen [-dir DIR] SIGNATURE ...
+//              Signature names material, for example KQvK or KRvKN (at most
+//              4 pieces). Tables that captures lead to are generated first,
+//              if they are not in directory yet.
+//
+//              Tables are computed backwards from the end (retrograde
+//              analysis): first all checkmates are found. Then positions
+//              resolved with distance N are taken back one move (un-move)
+//              to find their predecessors: predecessor of position lost in
+//              N plies is won in N+1 plies, and predecessor is lost when all
+//              its moves lead to won positions, in one ply more than the
+//              longest of them. Captures leave the table; their results are
+//              probed in smaller tables. Positions that are still unknown
+//              when no distance finds anything are draws.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+#include "Tablebase.h"
+#include "MoveGen.h"
+#include "Attacks.h"
+
+// Working values. Values that are known are stored as in file.
+static const short UNKNOWN = -1;
+static const short INVALID = -2;
+
+// Longest win of children that can't be lost (some move leads to draw or
+// to win).
+static const unsigned char CANT_LOSE = 255;
+
+// Function generate unmoves.
+// Adds moves that player "color" could have made to reach "position"
+// without capture: every piece goes back to empty square it could have
+// come from. Move goes from current square to that square.
+static void generate_unmoves(const Position& position, Color color,
+                             MoveList& moves) {
+    Bitboard occupied = position.get_occupied();
+
+    for(int type=PAWN; type<=KING; type++) {
+        Bitboard pieces = position.get_pieces(color,
+                                              static_cast<PieceType>(type));
+
+        while(pieces) {
+            int from = pop_first_index(pieces);
+
+            if(type != PAWN) {
+                Bitboard targets = piece_attacks(static_cast<PieceType>(type),
+                                                 from, occupied) & ~occupied;
+                while(targets)
+                    moves.add(Move(from, pop_first_index(targets)));
+                continue;
+            }
+
+            // Pawn steps back, but never to row where it can't be. Pawn
+            // on row 4 (5 for black) could also come from pawn line.
+            int back = (color == WHITE ? -8 : 8);
+            int row = from / 8;
+            int to = from + back;
+
+            if(color == WHITE ? row < 2 : row > 5) continue;
+            if(occupied & index_bit(to)) continue;
+            moves.add(Move(from, to));
+            if(row == (color == WHITE ? 3 : 4)
+               && !(occupied & index_bit(to + back)))
+                moves.add(Move(from, to + back));
+        }
+    }
+}
+
+// CLASS: Generator
+// ================
+// Generates one table. "pieces" holds pieces of table in order of index
+// (refer to "table_index" in Tablebase.h). For unknown positions it keeps
+// number of moves that stay in table and whose result is not known yet
+// ("remaining") and longest win of opponent found so far ("longest").
+// Resolved positions are queued by distance to mate: "found" holds
+// positions whose predecessors still have to be visited, "pending"
+// positions whose result is known to come at that distance, if nothing
+// shorter is found first.
+class Generator {
+private:
+    const Tablebase& tablebase;
+    vector<Piece> pieces;
+    unsigned long long size;
+    vector<short> values;
+    vector<unsigned char> remaining;
+    vector<unsigned char> longest;
+    vector<vector<unsigned>> found;
+    vector<vector<unsigned>> pending;
+
+    bool decode(unsigned long long index, Position& position, Color& turn);
+    void initialize(unsigned long long index);
+    void set_value(unsigned long long index, TbOutcome outcome, int plies);
+    void add_pending(unsigned long long index, int plies);
+    void retract(unsigned long long index, int plies);
+
+public:
+    Generator(const Tablebase& _tablebase, const Position& material);
+
+    void generate();
+    bool write(const string& path) const;
+};
+
+// Constructor.
+// Pieces are taken from "material", a position with pieces of the table
+// on any squares.
+Generator::Generator(const Tablebase& _tablebase, const Position& material)
+    : tablebase(_tablebase) {
+    static const PieceType ORDER[6] = {KING, QUEEN, ROOK, BISHOP, KNIGHT,
+                                       PAWN};
+
+    for(int color=WHITE; color<=BLACK; color++) {
+        for(int i=0; i<6; i++) {
+            int count = pop_count(material.get_pieces(
+                                      static_cast<Color>(color), ORDER[i]));
+            for(int j=0; j<count; j++)
+                pieces.push_back(make_piece(static_cast<Color>(color),
+                                            ORDER[i]));
+        }
+    }
+
+    size = 2;
+    for(size_t i=0; i<pieces.size(); i++)
+        size *= 64;
+}
+
+// Method: decode
+// Builds position of "index". Returns false if index is not valid: pieces
+// on the same square, pieces of the same type not in order of squares
+// (such index is never probed), pawn on row where it can't be (white pawn
+// on row 1, black on row 8) or player who is not on turn in chess.
+bool Generator::decode(unsigned long long index, Position& position,
+                       Color& turn) {
+    int n = static_cast<int>(pieces.size());
+    int squares[TB_MAX_PIECES];
+    Bitboard used = 0;
+
+    for(int i=n-1; i>=0; i--) {
+        squares[i] = static_cast<int>(index % 64);
+        index /= 64;
+    }
+    turn = static_cast<Color>(index);
+
+    position.clear();
+    for(int i=0; i<n; i++) {
+        Piece piece = pieces[i];
+        int row = squares[i] / 8;
+
+        if(used & index_bit(squares[i])) return false;
+        if(i > 0 && piece == pieces[i-1] && squares[i] < squares[i-1])
+            return false;
+        if(piece == WHITE_PAWN && row == 0) return false;
+        if(piece == BLACK_PAWN && row == 7) return false;
+
+        used |= index_bit(squares[i]);
+        position.put_piece(piece_color(piece), piece_type(piece),
+                           squares[i]);
+    }
+
+    Color other = inverse_color(turn);
+    int king = first_index(position.get_pieces(other, KING));
+    return !is_attacked(position, king, turn);
+}
+
+// Method: set value
+void Generator::set_value(unsigned long long index, TbOutcome outcome,
+                          int plies) {
+    TbResult result;
+
+    result.outcome = outcome;
+    result.plies = plies;
+    values[index] = tb_encode(result);
+}
+
+// Method: add pending
+// Distances that can't be stored are dropped, so such positions are draws.
+void Generator::add_pending(unsigned long long index, int plies) {
+    if(plies < TB_MAX_PLIES)
+        pending[plies].push_back(static_cast<unsigned>(index));
+}
+
+// Method: initialize
+// Counts moves of position "index" that stay in table and finds results of
+// captures, which are already known from smaller tables. Position without
+// legal move is checkmate (lost in 0 plies) or stalemate.
+void Generator::initialize(unsigned long long index) {
+    Position position;
+    MoveList moves;
+    Color turn;
+    int legal = 0, count = 0, win = -1, loss = 0;
+    bool cant_lose = false;
+
+    if(!decode(index, position, turn)) {
+        values[index] = INVALID;
+        return;
+    }
+
+    generate_moves(position, turn, moves);
+    for(int i=0; i<moves.size(); i++) {
+        Move move = moves[i];
+        Position child = position;
+        PieceType type = child.type_at(move.from());
+        bool capture = !child.is_empty(move.to());
+
+        if(capture) child.remove_piece(move.to());
+        child.remove_piece(move.from());
+        child.put_piece(turn, type, move.to());
+
+        int king = first_index(child.get_pieces(turn, KING));
+        if(is_attacked(child, king, inverse_color(turn))) continue;
+        legal++;
+
+        if(!capture) {
+            count++;
+            continue;
+        }
+
+        TbResult result;
+        if(!tablebase.probe(child, inverse_color(turn), result)) {
+            cerr << "Missing table " << material_signature(child) << "!"
+                 << endl;
+            exit(1);
+        }
+        if(result.outcome == TB_OUTCOME_WIN) {
+            loss = max(loss, result.plies + 1);
+            continue;
+        }
+        cant_lose = true;
+        if(result.outcome == TB_OUTCOME_LOSS
+           && (win < 0 || result.plies + 1 < win))
+            win = result.plies + 1;
+    }
+
+    if(legal == 0) {
+        int king = first_index(position.get_pieces(turn, KING));
+
+        if(is_attacked(position, king, inverse_color(turn)))
+            add_pending(index, 0);
+        else
+            set_value(index, TB_OUTCOME_DRAW, 0);
+        return;
+    }
+
+    remaining[index] = static_cast<unsigned char>(count);
+    longest[index] = cant_lose ? CANT_LOSE
+                               : static_cast<unsigned char>(min(loss,
+                                                                TB_MAX_PLIES));
+    if(win >= 0) add_pending(index, win);
+    else if(count == 0 && !cant_lose) add_pending(index, loss);
+}
+
+// Method: retract
+// Visits predecessors of position "index", which is resolved with distance
+// "plies" (refer to description of file).
+void Generator::retract(unsigned long long index, int plies) {
+    Position position;
+    MoveList moves;
+    Color turn;
+    TbResult result;
+
+    decode(index, position, turn);
+    tb_decode(static_cast<unsigned char>(values[index]), result);
+
+    Color other = inverse_color(turn);
+    generate_unmoves(position, other, moves);
+    for(int i=0; i<moves.size(); i++) {
+        Move move = moves[i];
+        Position parent = position;
+        PieceType type = parent.type_at(move.from());
+
+        parent.remove_piece(move.from());
+        parent.put_piece(other, type, move.to());
+
+        unsigned long long parent_index = table_index(parent, other, false);
+        if(values[parent_index] != UNKNOWN) continue;
+
+        if(result.outcome == TB_OUTCOME_LOSS) {
+            if(plies + 1 >= TB_MAX_PLIES) continue;
+            set_value(parent_index, TB_OUTCOME_WIN, plies + 1);
+            found[plies + 1].push_back(static_cast<unsigned>(parent_index));
+            continue;
+        }
+
+        remaining[parent_index]--;
+        if(longest[parent_index] == CANT_LOSE) continue;
+        if(longest[parent_index] < plies + 1)
+            longest[parent_index] = static_cast<unsigned char>(plies + 1);
+        if(remaining[parent_index] == 0)
+            add_pending(parent_index, longest[parent_index]);
+    }
+}
+
+// PUBLIC METHOD: generate
+// =======================
+// Distances are handled in increasing order, so when position is taken from
+// "pending", nothing shorter can be found for it any more.
+void Generator::generate() {
+    values.assign(size, UNKNOWN);
+    remaining.assign(size, 0);
+    longest.assign(size, 0);
+    found.assign(TB_MAX_PLIES, vector<unsigned>());
+    pending.assign(TB_MAX_PLIES, vector<unsigned>());
+
+    for(unsigned long long index=0; index<size; index++)
+        initialize(index);
+
+    for(int plies=0; plies<TB_MAX_PLIES; plies++) {
+        for(size_t i=0; i<pending[plies].size(); i++) {
+            unsigned index = pending[plies][i];
+
+            if(values[index] != UNKNOWN) continue;
+            set_value(index, longest[index] == CANT_LOSE ? TB_OUTCOME_WIN
+                                                         : TB_OUTCOME_LOSS,
+                      plies);
+            found[plies].push_back(index);
+        }
+        for(size_t i=0; i<found[plies].size(); i++)
+            retract(found[plies][i], plies);
+
+        vector<unsigned>().swap(pending[plies]);
+        vector<unsigned>().swap(found[plies]);
+    }
+
+    vector<unsigned char>().swap(remaining);
+    vector<unsigned char>().swap(longest);
+}
+
+// PUBLIC METHOD: write
+// ====================
+bool Generator::write(const string& path) const {
+    ofstream file(path, ios::binary);
+    char header[TB_HEADER_SIZE];
+    unsigned pieces_count = static_cast<unsigned>(pieces.size());
+
+    for(int i=0; i<4; i++) {
+        header[i] = TB_MAGIC[i];
+        header[4 + i] = static_cast<char>((pieces_count >> (8 * i)) & 255);
+    }
+    for(int i=0; i<8; i++)
+        header[8 + i] = static_cast<char>((size >> (8 * i)) & 255);
+    file.write(header, TB_HEADER_SIZE);
+
+    vector<char> bytes(size);
+    for(unsigned long long i=0; i<size; i++) {
+        short value = values[i];
+        if(value == UNKNOWN) value = TB_DRAW;
+        else if(value == INVALID) value = TB_INVALID;
+        bytes[i] = static_cast<char>(value);
+    }
+    file.write(bytes.data(), size);
+    return static_cast<bool>(file);
+}
+
+// Function signature position.
+// Puts pieces of "signature" on empty board (on any squares), so that
+// material can be read from Position. Returns false if signature is wrong.
+static bool signature_position(const string& signature, Position& position) {
+    int color = WHITE, square = 0, count = 0;
+
+    position.clear();
+    for(size_t i=0; i<signature.size(); i++) {
+        int type = 0;
+
+        if(signature[i] == 'v' && color == WHITE) {
+            color = BLACK;
+            continue;
+        }
+        while(type < 6 && PIECE_SYMBOLS[type] != signature[i]) type++;
+        if(type == 6) return false;
+
+        position.put_piece(static_cast<Color>(color),
+                           static_cast<PieceType>(type), square++);
+        count++;
+    }
+    return color == BLACK && count <= TB_MAX_PIECES
+           && pop_count(position.get_pieces(WHITE, KING)) == 1
+           && pop_count(position.get_pieces(BLACK, KING)) == 1;
+}
+
+// Function generate table.
+// Generates tables of all captures first (one piece less), then table
+// "signature" itself. Tables that are already in directory are skipped.
+static bool generate_table(Tablebase& tablebase, const string& directory,
+                           const Position& material) {
+    string signature = material_signature(material);
+
+    if(tablebase.has_table(material)) return true;
+
+    for(int color=WHITE; color<=BLACK; color++) {
+        for(int type=PAWN; type<KING; type++) {
+            Bitboard pieces = material.get_pieces(static_cast<Color>(color),
+                                                  static_cast<PieceType>(type));
+            if(!pieces) continue;
+
+            Position smaller = material;
+            smaller.remove_piece(first_index(pieces));
+            if(!generate_table(tablebase, directory, smaller)) return false;
+        }
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Generator generator(tablebase, material);
+    string path = directory + "/" + signature + TB_EXTENSION;
+
+    generator.generate();
+    if(!generator.write(path)) {
+        cerr << "Can't write " << path << "!" << endl;
+        return false;
+    }
+    cout << signature << ": "
+         << chrono::duration<double>(chrono::steady_clock::now()
+                                     - start).count() << " s" << endl;
+
+    tablebase.open(directory.c_str());
+    return true;
+}
+
+// Function print usage.
+static void print_usage() {
+    cerr << "Usage: chess-tbgen [-dir DIR] SIGNATURE ..." << endl;
+}
+
+int main(int argc, char* argv[]) {
+    string directory = ".";
+    Tablebase tablebase;
+    int tables = 0;
+
+    init_attacks();
+    for(int i=1; i<argc; i++) {
+        string arg = argv[i];
+
+        if(arg == "-dir" && i+1 < argc) {
+            directory = argv[++i];
+            continue;
+        }
+
+        Position material;
+        if(!signature_position(arg, material)) {
+            print_usage();
+            return 1;
+        }
+        tablebase.open(directory.c_str());
+        if(!generate_table(tablebase, directory, material)) return 1;
+        tables++;
+    }
+
+    if(tables == 0) {
+        print_usage();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: TranspositionTable.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to TranspositionTable.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TranspositionTable.h"
+
+// Layout of data word:
+//    bits 0-15: move, bits 16-31: score (+32768), bits 32-39: depth,
+//    bits 40-41: bound, bits 42-49: generation.
+static unsigned long long pack(Move move, int score, int depth, Bound bound,
+                               unsigned generation) {
+    return static_cast<unsigned long long>(move.get_data())
+        | (static_cast<unsigned long long>(score + 32768) << 16)
+        | (static_cast<unsigned long long>(depth & 255) << 32)
+        | (static_cast<unsigned long long>(bound) << 40)
+        | (static_cast<unsigned long long>(generation & 255) << 42);
+}
+
+static int data_depth(unsigned long long data) {
+    return (data >> 32) & 255;
+}
+
+static unsigned data_generation(unsigned long long data) {
+    return (data >> 42) & 255;
+}
+
+// Constructor.
+TranspositionTable::TranspositionTable(int megabytes) {
+    generation = 0;
+    resize(megabytes);
+}
+
+// Method: resize
+void TranspositionTable::resize(int megabytes) {
+    unsigned long long size = 1;
+    unsigned long long bytes = static_cast<unsigned long long>(megabytes)
+                               * 1024 * 1024;
+
+    while(2 * size * sizeof(Slot) <= bytes)
+        size *= 2;
+
+    slots = vector<Slot>(size);
+    mask = size - 1;
+    clear();
+}
+
+// Method: clear
+void TranspositionTable::clear() {
+    for(size_t i=0; i<slots.size(); i++) {
+        slots[i].check.store(0, memory_order_relaxed);
+        slots[i].data.store(0, memory_order_relaxed);
+    }
+}
+
+// Method: new search
+void TranspositionTable::new_search() {
+    generation++;
+}
+
+// Method: probe
+bool TranspositionTable::probe(Key key, TTEntry& entry) const {
+    const Slot& slot = slots[key & mask];
+    Key check = slot.check.load(memory_order_relaxed);
+    unsigned long long data = slot.data.load(memory_order_relaxed);
+
+    if((check ^ data) != key || data == 0) return false;
+
+    entry.move = Move::from_data(data & 0xFFFF);
+    entry.score = static_cast<int>((data >> 16) & 0xFFFF) - 32768;
+    entry.depth = data_depth(data);
+    entry.bound = static_cast<Bound>((data >> 40) & 3);
+    return true;
+}
+
+// Method: store
+// Entry of other position is replaced if it comes from older search or if
+// it was searched less deep. Entry of the same position is always replaced,
+// but its move is kept if new result has no move.
+void TranspositionTable::store(Key key, Move move, int score, int depth,
+                               Bound bound) {
+    Slot& slot = slots[key & mask];
+    Key check = slot.check.load(memory_order_relaxed);
+    unsigned long long old = slot.data.load(memory_order_relaxed);
+    bool same = ((check ^ old) == key);
+
+    if(!same && old != 0 && data_generation(old) == (generation & 255)
+       && data_depth(old) > depth)
+        return;
+
+    if(same && move.is_null())
+        move = Move::from_data(old & 0xFFFF);
+
+    unsigned long long data = pack(move, score, depth, bound, generation);
+    slot.check.store(key ^ data, memory_order_relaxed);
+    slot.data.store(data, memory_order_relaxed);
+}
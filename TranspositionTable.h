@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: TranspositionTable.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file for transposition table, hash table of search
+//              results indexed by Zobrist key of position. Same position is
+//              often reached by different orders of moves; with table it is
+//              searched only once. Table also remembers best move of
+//              position, which is searched first next time.
+//
+//              Table is shared by all search threads without locks. Every
+//              entry is stored as two 64 bit words, data and key XOR data.
+//              If two threads write the same entry at once, the words can
+//              come from different writes; then XOR doesn't give key back
+//              and entry is treated as empty.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRANSPOSITIONTABLE_H_
+#define TRANSPOSITIONTABLE_H_
+
+#include <atomic>
+#include <vector>
+
+#include "Move.h"
+#include "Zobrist.h"
+
+using namespace std;
+
+
+// Enumerator: Bound tells what stored score means. Search that fails low
+// only knows upper bound of score, search that fails high only knows lower
+// bound.
+enum Bound {
+    BOUND_NONE,
+    BOUND_UPPER,
+    BOUND_LOWER,
+    BOUND_EXACT
+};
+
+// STRUCT: TTEntry
+// ===============
+// Unpacked entry of table.
+struct TTEntry {
+    Move move;
+    int score;
+    int depth;
+    Bound bound;
+};
+
+// CLASS: TranspositionTable
+// =========================
+class TranspositionTable {
+private:
+    struct Slot {
+        atomic<Key> check;  // key ^ data
+        atomic<unsigned long long> data;
+    };
+
+    vector<Slot> slots;
+    unsigned long long mask;
+    unsigned generation;  // increased by every search
+
+public:
+    // Table takes "megabytes" MB (rounded down to power of 2 entries).
+    TranspositionTable(int megabytes);
+
+    // Method resize changes size of table and clears it. Method clear
+    // removes all entries. Neither can be called during search.
+    void resize(int megabytes);
+    void clear();
+
+    // Method new search is called before every search. Entries of older
+    // searches are replaced first.
+    void new_search();
+
+    bool probe(Key key, TTEntry& entry) const;
+    void store(Key key, Move move, int score, int depth, Bound bound);
+};
+
+
+#endif // TRANSPOSITIONTABLE_H_
@@ -0,0 +1,376 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Uci.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: UCI front-end. Engine reads commands of Universal Chess
+//              Interface from standard input and answers on standard output,
+//              so it can be used by chess GUIs and tournament programs.
+//
+//              Supported commands:
+//                  uci, isready, ucinewgame, quit,
+//                  setoption name Hash|Threads value N,
+//                  setoption name TablebasePath value DIR,
+//                  setoption name BookFile value FILE,
+//                  position startpos|fen FEN [moves M ...],
+//                  go [depth N] [nodes N] [movetime MS] [wtime MS]
+//                     [btime MS] [winc MS] [binc MS] [movestogo N]
+//                     [infinite],
+//                  stop.
+//              Moves are written as e2e4. Unknown commands are ignored.
+//              If opening book is set (refer to Book.h) and position is in
+//              it, "go" is answered with book move at once, without search.
+//
+//              Main thread only reads commands; search runs on its own
+//              thread. So "stop" (and "isready") is handled while engine
+//              is thinking: it sets cancel flag of search (refer to
+//              SearchLimits in Search.h), which stops it within a few
+//              thousand nodes. With "go infinite", best move is sent only
+//              after "stop", even if search finishes earlier (found mate).
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
+
+using namespace std;
+
+#include "ChessBoard.hpp"
+#include "Search.h"
+#include "Book.h"
+
+// Starting position.
+static const char* START_FEN =
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - - 0 1";
+
+// Time control: without "movestogo", remaining time is divided as if this
+// many moves were left. MOVE_OVERHEAD milliseconds are kept for reading
+// and sending commands.
+static const int DEFAULT_MOVES_TO_GO = 30;
+static const int MOVE_OVERHEAD = 20;
+
+// Limits of options.
+static const int MAX_HASH_MB = 4096;
+static const int MAX_THREADS = 256;
+
+// Lines are sent from main thread and from search thread.
+static mutex output_mutex;
+
+// Function send.
+// Sends one line to GUI.
+static void send(const string& line) {
+    lock_guard<mutex> lock(output_mutex);
+    cout << line << "\n";
+    cout.flush();
+}
+
+// Function move to uci.
+// Writes Move "move" as e2e4; "no move" is 0000.
+static string move_to_uci(Move move) {
+    string result;
+
+    if(move.is_null()) return "0000";
+    result += static_cast<char>('a' + move.from() % 8);
+    result += static_cast<char>('1' + move.from() / 8);
+    result += static_cast<char>('a' + move.to() % 8);
+    result += static_cast<char>('1' + move.to() / 8);
+    return result;
+}
+
+// Function play uci move.
+// Plays move written as e2e4 (upper case is accepted too). Returns false if
+// move is written wrong or isn't legal.
+static bool play_uci_move(ChessBoard& board, string_view move_str) {
+    char start[2], end[2];
+    Square start_square, end_square;
+
+    if(move_str.length() != 4) return false;
+    start[0] = static_cast<char>(toupper(move_str[0]));
+    start[1] = move_str[1];
+    end[0] = static_cast<char>(toupper(move_str[2]));
+    end[1] = move_str[3];
+
+    if(!string_to_square(string_view(start, 2), start_square)
+       || !string_to_square(string_view(end, 2), end_square))
+        return false;
+    return move_accepted(board.submitMove(start_square, end_square).status);
+}
+
+// CLASS: UciListener
+// ==================
+// Sends every finished depth as "info" line.
+class UciListener: public SearchListener {
+public:
+    void iteration(const SearchInfo& info) {
+        ostringstream line;
+
+        line << "info depth " << info.depth << " score ";
+        if(is_mate_score(info.score)) {
+            int plies = MATE_SCORE - (info.score > 0 ? info.score
+                                                     : -info.score);
+            int moves = (plies + 1) / 2;
+            line << "mate " << (info.score > 0 ? moves : -moves);
+        }
+        else {
+            line << "cp " << info.score;
+        }
+        line << " nodes " << info.nodes
+             << " time " << static_cast<long long>(info.seconds * 1000)
+             << " nps " << info.nps << " pv";
+        for(int i=0; i<info.pv_length; i++)
+            line << " " << move_to_uci(info.pv[i]);
+        send(line.str());
+    }
+};
+
+// CLASS: UciEngine
+// ================
+// Keeps game position and search, and runs commands.
+class UciEngine {
+private:
+    ChessBoard board;
+    Search search;
+    Tablebase tablebase;
+    Book book;
+    mt19937_64 random;
+    UciListener listener;
+    thread searcher;
+    atomic<bool> cancel;
+    mutex cancel_mutex;
+    condition_variable cancelled;
+
+    void stop_search();
+    void think(ChessBoard position, SearchLimits limits, bool infinite);
+
+    void set_option(istringstream& args);
+    void set_position(istringstream& args);
+    void go(istringstream& args);
+
+public:
+    UciEngine();
+    ~UciEngine();
+
+    // Runs one command. Returns false on "quit".
+    bool command(const string& line);
+};
+
+// Constructor.
+UciEngine::UciEngine() : board(NULL), random(random_device()()) {
+    cancel = false;
+    search.set_tablebase(&tablebase);
+    board.from_fen(START_FEN);
+}
+
+// Destructor.
+UciEngine::~UciEngine() {
+    stop_search();
+}
+
+// Method: stop search
+// Stops search that is running (if any) and waits until it sends its best
+// move.
+void UciEngine::stop_search() {
+    if(!searcher.joinable()) return;
+    {
+        lock_guard<mutex> lock(cancel_mutex);
+        cancel = true;
+    }
+    cancelled.notify_all();
+    searcher.join();
+}
+
+// Method: think
+// Body of search thread. With "infinite", thread waits for "stop" before
+// it sends best move.
+void UciEngine::think(ChessBoard position, SearchLimits limits,
+                      bool infinite) {
+    Move best = search.think(position, limits, &listener);
+
+    if(infinite) {
+        unique_lock<mutex> lock(cancel_mutex);
+        cancelled.wait(lock, [this] { return cancel.load(); });
+    }
+    send("bestmove " + move_to_uci(best));
+}
+
+// Method: set option
+// setoption name <name> value <value>
+// Value is the rest of line, so path can contain spaces.
+void UciEngine::set_option(istringstream& args) {
+    string token, name, value;
+
+    while(args >> token) {
+        if(token == "name") {
+            args >> name;
+        }
+        else if(token == "value") {
+            getline(args >> ws, value);
+            break;
+        }
+    }
+
+    if(name == "Hash") {
+        int hash_mb = atoi(value.c_str());
+        if(1 <= hash_mb && hash_mb <= MAX_HASH_MB) search.set_hash(hash_mb);
+    }
+    else if(name == "Threads") {
+        int threads = atoi(value.c_str());
+        if(1 <= threads && threads <= MAX_THREADS)
+            search.set_threads(threads);
+    }
+    else if(name == "TablebasePath") {
+        if(value.empty() || value == "<empty>") tablebase.close();
+        else tablebase.open(value.c_str());
+    }
+    else if(name == "BookFile") {
+        if(value.empty() || value == "<empty>") book.close();
+        else book.open(value.c_str());
+    }
+}
+
+// Method: set position
+// position startpos|fen <FEN> [moves <move> ...]
+// Position is set first and moves are played after it. Illegal move and
+// all that follow it are ignored.
+void UciEngine::set_position(istringstream& args) {
+    string token, fen;
+
+    args >> token;
+    if(token == "startpos") {
+        fen = START_FEN;
+        args >> token;
+    }
+    else if(token == "fen") {
+        while(args >> token && token != "moves")
+            fen += (fen.empty() ? "" : " ") + token;
+    }
+    else {
+        return;
+    }
+
+    if(!board.from_fen(fen)) {
+        board.from_fen(START_FEN);
+        return;
+    }
+
+    if(token != "moves") return;
+    while(args >> token) {
+        if(!play_uci_move(board, token)) break;
+    }
+}
+
+// Method: go
+// Book move is played if there is one, except with "infinite", where GUI
+// waits for "stop". Otherwise clock of player on turn is converted to soft
+// and hard limit: soft limit is fair share of remaining time, hard limit
+// lets search use up to three times as much, but never more than remaining
+// time.
+void UciEngine::go(istringstream& args) {
+    SearchLimits limits;
+    string token;
+    int times[2] = {0, 0}, increments[2] = {0, 0};
+    int moves_to_go = 0;
+    bool infinite = false;
+
+    while(args >> token) {
+        if(token == "infinite") infinite = true;
+        else if(token == "depth") args >> limits.depth;
+        else if(token == "nodes") args >> limits.nodes;
+        else if(token == "movetime") args >> limits.milliseconds;
+        else if(token == "wtime") args >> times[WHITE];
+        else if(token == "btime") args >> times[BLACK];
+        else if(token == "winc") args >> increments[WHITE];
+        else if(token == "binc") args >> increments[BLACK];
+        else if(token == "movestogo") args >> moves_to_go;
+    }
+
+    Color turn = board.get_turn();
+    if(!infinite && book.size() > 0) {
+        Move move = book.pick_move(board.get_position(), turn, random());
+        if(!move.is_null()) {
+            send("bestmove " + move_to_uci(move));
+            return;
+        }
+    }
+
+    if(times[turn] > 0 && limits.milliseconds <= 0) {
+        int left = times[turn] - MOVE_OVERHEAD;
+        int moves = moves_to_go > 0 ? moves_to_go : DEFAULT_MOVES_TO_GO;
+        int soft = left / moves + increments[turn];
+        int hard = 3 * soft;
+
+        if(hard > left) hard = left;
+        if(soft > hard) soft = hard;
+        limits.soft_milliseconds = soft > 1 ? soft : 1;
+        limits.milliseconds = hard > 1 ? hard : 1;
+    }
+
+    cancel = false;
+    limits.cancel = &cancel;
+    searcher = thread(&UciEngine::think, this, board, limits, infinite);
+}
+
+// PUBLIC METHOD: command
+// ======================
+bool UciEngine::command(const string& line) {
+    istringstream args(line);
+    string name;
+
+    if(!(args >> name)) return true;
+
+    if(name == "uci") {
+        send("id name Chess");
+        send("id author Erik Grabljevec");
+        send("option name Hash type spin default "
+             + to_string(DEFAULT_HASH_MB) + " min 1 max "
+             + to_string(MAX_HASH_MB));
+        send("option name Threads type spin default 1 min 1 max "
+             + to_string(MAX_THREADS));
+        send("option name TablebasePath type string default <empty>");
+        send("option name BookFile type string default <empty>");
+        send("uciok");
+    }
+    else if(name == "isready") {
+        send("readyok");
+    }
+    else if(name == "ucinewgame") {
+        stop_search();
+        search.clear();
+        board.from_fen(START_FEN);
+    }
+    else if(name == "setoption") {
+        stop_search();
+        set_option(args);
+    }
+    else if(name == "position") {
+        stop_search();
+        set_position(args);
+    }
+    else if(name == "go") {
+        stop_search();
+        go(args);
+    }
+    else if(name == "stop") {
+        stop_search();
+    }
+    else if(name == "quit") {
+        stop_search();
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    UciEngine engine;
+    string line;
+
+    while(getline(cin, line)) {
+        if(!engine.command(line)) break;
+    }
+    return 0;
+}
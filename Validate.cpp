@@ -0,0 +1,375 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Validate.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Batch validation tool. It replays all games of given PGN
+//              files on all cores and prints verdict for every game
+//              (number of moves, result, first illegal move) and totals.
+//
+//              Usage: chess-validate [-threads N] [-chunk MB] [-quiet]
+//                                    [-archive FILE] file ...
+//              Files are mapped in memory (refer to MappedFile.h) and split
+//              into chunks of about given size (default 4 MB), always at
+//              start of game, so one big file is validated by all threads
+//              too. Games are read straight from mapping. Every thread has
+//              its own ChessBoard and own queue of chunks. Thread that
+//              empties its queue steals chunks from queues of other
+//              threads, so threads that got long games don't hold back the
+//              rest.
+//              With -quiet only illegal games and totals are printed.
+//              With -archive, legal games are also written to binary archive
+//              (refer to GameArchive.h), in the same order as in files.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+#include "ChessBoard.hpp"
+#include "PgnReader.h"
+#include "MappedFile.h"
+#include "GameArchive.h"
+
+// STRUCT: Chunk
+// =============
+// Part of file that starts with game and ends before game (or at the end of
+// file). "games" and "moves" (moves of all games, one after another) are
+// filled by thread that validates the chunk.
+struct Chunk {
+    int file;
+    string_view text;
+    vector<PgnGame> games;
+    vector<Move> moves;
+};
+
+// CLASS: MoveCollector
+// ====================
+// Visitor that keeps moves of games, so they can be written to archive.
+class MoveCollector: public PgnVisitor {
+private:
+    vector<Move>& moves;
+
+public:
+    MoveCollector(vector<Move>& _moves) : moves(_moves) {}
+
+    void move(const MoveResult& result) {
+        moves.push_back(archive_move(result));
+    }
+};
+
+// CLASS: WorkQueue
+// ================
+// Queue of chunk numbers of one thread. Owner takes chunks from the back,
+// other threads steal from the front, so they take work the owner would
+// reach last.
+class WorkQueue {
+private:
+    mutex lock;
+    deque<int> chunks;
+
+public:
+    void push(int chunk);
+    bool pop(int& chunk);
+    bool steal(int& chunk);
+};
+
+void WorkQueue::push(int chunk) {
+    lock_guard<mutex> guard(lock);
+    chunks.push_back(chunk);
+}
+
+bool WorkQueue::pop(int& chunk) {
+    lock_guard<mutex> guard(lock);
+    if(chunks.empty()) return false;
+    chunk = chunks.back();
+    chunks.pop_back();
+    return true;
+}
+
+bool WorkQueue::steal(int& chunk) {
+    lock_guard<mutex> guard(lock);
+    if(chunks.empty()) return false;
+    chunk = chunks.front();
+    chunks.pop_front();
+    return true;
+}
+
+// STRUCT: Totals
+// ==============
+struct Totals {
+    long long games;
+    long long illegal;
+    long long plies;
+    long long archived;
+};
+
+// CLASS: Printer
+// ==============
+// Prints verdicts of chunks in the same order as they are in files, although
+// threads finish them in any order. Games of chunk are freed once they are
+// printed.
+class Printer {
+private:
+    mutex lock;
+    vector<Chunk>& chunks;
+    const vector<string>& files;
+    vector<bool> done;
+    int next;              // first chunk that wasn't printed yet
+    long long file_games;  // games printed from current file
+    bool quiet;
+    ArchiveWriter* archive;  // NULL if games are not archived
+
+    void print_chunk(Chunk& chunk);
+
+public:
+    Totals totals;
+
+    Printer(vector<Chunk>& _chunks, const vector<string>& _files,
+            bool _quiet, ArchiveWriter* _archive);
+
+    // Method finished marks chunk as validated and prints all chunks that
+    // can be printed.
+    void finished(int chunk);
+};
+
+Printer::Printer(vector<Chunk>& _chunks, const vector<string>& _files,
+                 bool _quiet, ArchiveWriter* _archive)
+    : chunks(_chunks), files(_files), done(_chunks.size(), false) {
+    next = 0;
+    file_games = 0;
+    quiet = _quiet;
+    archive = _archive;
+    totals.games = 0;
+    totals.illegal = 0;
+    totals.plies = 0;
+    totals.archived = 0;
+}
+
+void Printer::print_chunk(Chunk& chunk) {
+    size_t first_move = 0;
+
+    for(size_t i=0; i<chunk.games.size(); i++) {
+        const PgnGame& game = chunk.games[i];
+
+        file_games++;
+        totals.games++;
+        totals.plies += game.plies;
+        if(!game.ok) totals.illegal++;
+
+        // Archive games always start from starting position.
+        if(archive != NULL && game.ok && !game.from_fen) {
+            for(int j=0; j<game.plies; j++)
+                archive->add_move(chunk.moves[first_move + j]);
+            archive->end_game(string_to_result(game.result));
+            totals.archived++;
+        }
+        first_move += game.plies;
+
+        if(quiet && game.ok) continue;
+
+        cout << files[chunk.file] << " game " << file_games << ": "
+             << (game.ok ? "OK" : "ILLEGAL") << ", " << game.plies
+             << " moves";
+        if(game.result[0] != '\0') cout << ", " << game.result;
+        if(!game.ok) cout << ", " << game.error;
+        if(game.error_move[0] != '\0') cout << " " << game.error_move;
+        cout << "\n";
+    }
+    vector<PgnGame>().swap(chunk.games);
+    vector<Move>().swap(chunk.moves);
+}
+
+void Printer::finished(int chunk) {
+    lock_guard<mutex> guard(lock);
+
+    done[chunk] = true;
+    while(next < static_cast<int>(chunks.size()) && done[next]) {
+        if(next > 0 && chunks[next].file != chunks[next-1].file)
+            file_games = 0;
+        print_chunk(chunks[next]);
+        next++;
+    }
+}
+
+// Function validate chunk.
+// Moves are collected only if they will be archived.
+static void validate_chunk(ChessBoard& board, Chunk& chunk, bool collect) {
+    PgnReader reader(chunk.text);
+    MoveCollector collector(chunk.moves);
+    PgnGame game;
+
+    while(reader.read_game(board, game, collect ? &collector : NULL))
+        chunk.games.push_back(game);
+}
+
+// Function worker.
+// Thread "id" validates chunks from its own queue and then steals from
+// others. No chunks are added while threads run, so when all queues are
+// empty, work is done.
+static void worker(int id, vector<WorkQueue>& queues, vector<Chunk>& chunks,
+                   Printer& printer, bool collect) {
+    ChessBoard board(NULL);
+    int n = queues.size();
+    int chunk;
+
+    while(true) {
+        bool found = queues[id].pop(chunk);
+
+        for(int i=1; !found && i<n; i++)
+            found = queues[(id + i) % n].steal(chunk);
+        if(!found) break;
+
+        validate_chunk(board, chunks[chunk], collect);
+        printer.finished(chunk);
+    }
+}
+
+// Function game start.
+// Finds first game in "text" that starts after "offset": first tag line that
+// follows blank or movetext line. Line in which "offset" lands is skipped,
+// as we can't tell what was before it. Returns size of "text" if there is no
+// such game.
+static size_t game_start(string_view text, size_t offset) {
+    bool after_tags = true;  // previous line is tag line (or unknown)
+    size_t line = text.find('\n', offset);
+
+    while(line != string_view::npos) {
+        line++;
+        if(line < text.size() && text[line] == '[' && !after_tags)
+            return line;
+        after_tags = (line < text.size() && text[line] == '[');
+        line = text.find('\n', line);
+    }
+    return text.size();
+}
+
+// Function split file.
+// Adds chunks of mapped file "index" to "chunks".
+static void split_file(string_view text, int index, size_t chunk_size,
+                       vector<Chunk>& chunks) {
+    size_t begin = 0;
+
+    while(begin < text.size()) {
+        size_t end = text.size();
+
+        if(begin + chunk_size < text.size())
+            end = game_start(text, begin + chunk_size);
+
+        Chunk chunk;
+        chunk.file = index;
+        chunk.text = text.substr(begin, end - begin);
+        chunks.push_back(chunk);
+        begin = end;
+    }
+}
+
+// Function print usage.
+static void print_usage() {
+    cerr << "Usage: chess-validate [-threads N] [-chunk MB] [-quiet]"
+         << " [-archive FILE] file ..." << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = thread::hardware_concurrency();
+    size_t chunk_size = 4 * 1024 * 1024;
+    bool quiet = false;
+    const char* archive_path = NULL;
+    ArchiveWriter archive;
+    vector<string> files;
+    vector<Chunk> chunks;
+
+    for(int i=1; i<argc; i++) {
+        string arg = argv[i];
+
+        if(arg == "-threads" && i+1 < argc) {
+            threads = atoi(argv[++i]);
+        }
+        else if(arg == "-chunk" && i+1 < argc) {
+            long long megabytes = atoll(argv[++i]);
+            chunk_size = (megabytes < 1 ? 1 : megabytes) * 1024 * 1024;
+        }
+        else if(arg == "-quiet") {
+            quiet = true;
+        }
+        else if(arg == "-archive" && i+1 < argc) {
+            archive_path = argv[++i];
+        }
+        else {
+            files.push_back(arg);
+        }
+    }
+    if(threads < 1) threads = 1;
+
+    if(files.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    vector<MappedFile> maps(files.size());
+
+    for(size_t i=0; i<files.size(); i++) {
+        if(!maps[i].open(files[i].c_str())) {
+            cerr << "Can't open " << files[i] << "!" << endl;
+            return 1;
+        }
+        split_file(maps[i].get_view(), i, chunk_size, chunks);
+    }
+
+    if(archive_path != NULL && !archive.open(archive_path)) {
+        cerr << "Can't write " << archive_path << "!" << endl;
+        return 1;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    vector<WorkQueue> queues(threads);
+    Printer printer(chunks, files, quiet,
+                    archive_path != NULL ? &archive : NULL);
+    vector<thread> workers;
+
+    // Neighbouring chunks go to different threads.
+    for(size_t i=0; i<chunks.size(); i++)
+        queues[i % threads].push(i);
+
+    for(int i=0; i<threads; i++) {
+        workers.push_back(thread(worker, i, ref(queues), ref(chunks),
+                                 ref(printer), archive_path != NULL));
+    }
+    for(int i=0; i<threads; i++)
+        workers[i].join();
+
+    if(archive_path != NULL && !archive.close()) {
+        cerr << "Can't write " << archive_path << "!" << endl;
+        return 1;
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                              - start).count();
+    const Totals& totals = printer.totals;
+
+    cout << "\n";
+    cout << "Files: " << files.size() << "\n";
+    cout << "Chunks: " << chunks.size() << "\n";
+    cout << "Threads: " << threads << "\n";
+    cout << "Games: " << totals.games << "\n";
+    cout << "Legal: " << totals.games - totals.illegal << "\n";
+    cout << "Illegal: " << totals.illegal << "\n";
+    cout << "Moves: " << totals.plies << "\n";
+    if(archive_path != NULL)
+        cout << "Archived: " << totals.archived << "\n";
+    cout << "Time: " << seconds << " s\n";
+    if(seconds > 0)
+        cout << "Speed: " << static_cast<long long>(totals.games / seconds)
+             << " games/s, " << static_cast<long long>(totals.plies / seconds)
+             << " moves/s\n";
+
+    return totals.illegal > 0 ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Zobrist.cpp
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Refer to Zobrist.h.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Zobrist.h"
+
+// Function next random.
+// Xorshift64* generator. It is constexpr, so keys are computed by compiler.
+static constexpr Key next_random(Key& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+// Function make zobrist keys.
+static constexpr ZobristKeys make_zobrist_keys() {
+    ZobristKeys keys = {};
+    Key state = 0x4D595DF4D0F33173ULL;
+
+    for(int color=0; color<2; color++) {
+        for(int type=0; type<6; type++) {
+            for(int index=0; index<64; index++)
+                keys.pieces[color][type][index] = next_random(state);
+        }
+    }
+    keys.black_to_move = next_random(state);
+    return keys;
+}
+
+constexpr ZobristKeys ZOBRIST = make_zobrist_keys();
@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: Zobrist.h
+// Author: Erik Grabljevec
+// Email: erikgrabljevec5@gmail.com
+// Description: Header file with Zobrist keys. Zobrist key of position is XOR
+//              of random numbers, one for every piece on its square and one
+//              for side to move. When piece moves, key is updated with two
+//              XORs, so equal positions can be compared with one 64-bit
+//              comparison.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ZOBRIST_H_
+#define ZOBRIST_H_
+
+#include "Piece.h"
+
+
+// TYPEDEFs
+// ========
+typedef unsigned long long Key;
+
+// STRUCT: ZobristKeys
+// ===================
+// Random numbers for every (color, piece type, square) and for black to
+// move. If game ever gets additional state (castling rights, ...), its keys
+// belong here as well.
+struct ZobristKeys {
+    Key pieces[2][6][64];  // pieces[color][type][index]
+    Key black_to_move;
+};
+
+// Keys are generated at compile time with fixed seed, so every run (and every
+// thread) uses the same keys and nothing has to be initialized.
+extern const ZobristKeys ZOBRIST;
+
+
+#endif // ZOBRIST_H_